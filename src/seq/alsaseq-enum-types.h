@@ -399,6 +399,20 @@ typedef enum {
     ALSASEQ_EVENT_ERROR_INVALID_TSTAMP_MODE,
 } ALSASeqEventError;
 
+/**
+ * ALSASeqSmfPlayerError:
+ * @ALSASEQ_SMF_PLAYER_ERROR_FAILED:                General error due to unspecified reason.
+ * @ALSASEQ_SMF_PLAYER_ERROR_INVALID_FORMAT:        The content of file is not Standard MIDI File.
+ * @ALSASEQ_SMF_PLAYER_ERROR_UNSUPPORTED_DIVISION:  The division of time is not supported.
+ *
+ * A set of error code for [struct@GLib.Error] with `struct@SmfPlayerError` domain.
+ */
+typedef enum {
+    ALSASEQ_SMF_PLAYER_ERROR_FAILED = 0,
+    ALSASEQ_SMF_PLAYER_ERROR_INVALID_FORMAT,
+    ALSASEQ_SMF_PLAYER_ERROR_UNSUPPORTED_DIVISION,
+} ALSASeqSmfPlayerError;
+
 G_END_DECLS
 
 #endif
@@ -17,7 +17,6 @@
 #include <event-data-connect.h>
 #include <event-data-result.h>
 #include <remove-filter.h>
-#include <event-cntr.h>
 
 #include <queue-timer-common.h>
 
@@ -26,15 +25,24 @@
 #include <client-pool.h>
 #include <port-info.h>
 #include <subscribe-data.h>
-#include <event-cntr.h>
 #include <event.h>
+#include <event-cntr.h>
 #include <queue-info.h>
 #include <queue-status.h>
 #include <queue-tempo.h>
 #include <queue-timer-alsa.h>
 
+#include <user-client-stats.h>
+#include <forward-route.h>
 #include <user-client.h>
+#include <topology.h>
+#include <client-engine.h>
+#include <smf-player.h>
+#include <smf-recorder.h>
+#include <tempo-map.h>
+#include <sysex-transfer.h>
 
 #include <query.h>
+#include <query-session.h>
 
 #endif
@@ -0,0 +1,879 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/**
+ * ALSASeqClientEngine:
+ * A GObject-derived object to multiplex I/O of several user clients.
+ *
+ * A [class@ClientEngine] is a GObject-derived object to multiplex I/O of several instances of
+ * [class@UserClient] in single [struct@GLib.Source]. When io_uring is available in the running
+ * kernel (Linux kernel v5.7 or later), the engine submits the requests to read events from all of
+ * the clients and the requests to write events scheduled by
+ * [method@ClientEngine.schedule_event_cntr] by single `io_uring_enter(2)` system call in each
+ * iteration of [struct@GLib.MainContext], then the completed reads are dispatched for
+ * [signal@UserClient::handle-event] signal of each client. Else the engine falls back to the
+ * source created by [method@UserClient.create_source_full] for each client, which is added to the
+ * source of engine as child.
+ *
+ * When any request for the client fails, [signal@ClientEngine::client-error] signal is emitted.
+ */
+typedef struct {
+    ALSASeqUserClient *client;
+    int fd;
+    guint8 *buf;
+    gsize buf_len;
+    gboolean failed;
+    gboolean write_blocked;
+    GByteArray *pending;
+    guint8 *inflight;
+    gsize inflight_len;
+} EngineEntry;
+
+typedef struct {
+    GPtrArray *entries;
+    gboolean source_created;
+    guint64 write_error_count;
+
+    gboolean uring;
+    int ring_fd;
+    void *sq_ptr;
+    gsize sq_size;
+    void *cq_ptr;
+    gsize cq_size;
+    struct io_uring_sqe *sqes;
+    gsize sqes_size;
+    unsigned int *sq_head;
+    unsigned int *sq_tail;
+    unsigned int sq_mask;
+    unsigned int sq_entries;
+    unsigned int *sq_array;
+    unsigned int *cq_head;
+    unsigned int *cq_tail;
+    unsigned int cq_mask;
+    struct io_uring_cqe *cqes;
+    unsigned int to_submit;
+    unsigned int inflight;
+    int submit_error;
+} ALSASeqClientEnginePrivate;
+G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqClientEngine, alsaseq_client_engine, G_TYPE_OBJECT)
+
+#define generate_syscall_error(exception, errno, fmt, arg) \
+        g_set_error(exception, ALSASEQ_USER_CLIENT_ERROR, ALSASEQ_USER_CLIENT_ERROR_FAILED, \
+                    fmt" %d(%s)", arg, errno, strerror(errno))
+
+enum seq_client_engine_prop_type {
+    SEQ_CLIENT_ENGINE_PROP_IO_URING = 1,
+    SEQ_CLIENT_ENGINE_PROP_WRITE_ERROR_COUNT,
+    SEQ_CLIENT_ENGINE_PROP_COUNT,
+};
+static GParamSpec *seq_client_engine_props[SEQ_CLIENT_ENGINE_PROP_COUNT] = { NULL, };
+
+enum seq_client_engine_sig_type {
+    SEQ_CLIENT_ENGINE_SIG_TYPE_CLIENT_ERROR = 0,
+    SEQ_CLIENT_ENGINE_SIG_TYPE_COUNT,
+};
+static guint seq_client_engine_sigs[SEQ_CLIENT_ENGINE_SIG_TYPE_COUNT] = { 0 };
+
+// The number of entries in submission queue.
+#define RING_ENTRIES    64
+
+// The maximum number of read(2) in each dispatch of the source for client at fallback.
+#define FALLBACK_MAX_READS  8
+
+// The type of request is encoded to the lower bits of user data.
+enum engine_op_type {
+    ENGINE_OP_POLL = 0,
+    ENGINE_OP_READ,
+    ENGINE_OP_WRITE,
+    ENGINE_OP_CANCEL,
+    ENGINE_OP_POLL_OUT,
+    ENGINE_OP_MASK = 0x7,
+};
+
+#define ENCODE_USER_DATA(entry, op)     ((__u64)(guintptr)(entry) | (op))
+#define DECODE_ENTRY(user_data) \
+        ((EngineEntry *)(guintptr)((user_data) & ~(__u64)ENGINE_OP_MASK))
+#define DECODE_OP(user_data)            ((user_data) & ENGINE_OP_MASK)
+
+static void engine_entry_free(gpointer data)
+{
+    EngineEntry *entry = data;
+
+    g_object_unref(entry->client);
+    g_free(entry->buf);
+    g_byte_array_free(entry->pending, TRUE);
+    g_free(entry->inflight);
+    g_free(entry);
+}
+
+static void engine_release_ring(ALSASeqClientEnginePrivate *priv)
+{
+    if (priv->ring_fd >= 0)
+        close(priv->ring_fd);
+    priv->ring_fd = -1;
+
+    if (priv->sqes != NULL)
+        munmap(priv->sqes, priv->sqes_size);
+    if (priv->cq_ptr != NULL && priv->cq_ptr != priv->sq_ptr)
+        munmap(priv->cq_ptr, priv->cq_size);
+    if (priv->sq_ptr != NULL)
+        munmap(priv->sq_ptr, priv->sq_size);
+    priv->sqes = NULL;
+    priv->cq_ptr = NULL;
+    priv->sq_ptr = NULL;
+
+    priv->uring = FALSE;
+}
+
+static gboolean engine_setup_ring(ALSASeqClientEnginePrivate *priv)
+{
+    struct io_uring_params params = {0};
+    guint8 *sq_ptr;
+    guint8 *cq_ptr;
+
+    priv->ring_fd = syscall(__NR_io_uring_setup, RING_ENTRIES, &params);
+    if (priv->ring_fd < 0)
+        return FALSE;
+
+    // The poll of character device and the request to read/write at current position are
+    // available in Linux kernel v5.7 or later.
+    if (!(params.features & IORING_FEAT_FAST_POLL) || !(params.features & IORING_FEAT_RW_CUR_POS))
+        goto failed;
+
+    priv->sq_size = params.sq_off.array + params.sq_entries * sizeof(__u32);
+    priv->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        priv->sq_size = MAX(priv->sq_size, priv->cq_size);
+        priv->cq_size = priv->sq_size;
+    }
+
+    priv->sq_ptr = mmap(NULL, priv->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        priv->ring_fd, IORING_OFF_SQ_RING);
+    if (priv->sq_ptr == MAP_FAILED) {
+        priv->sq_ptr = NULL;
+        goto failed;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        priv->cq_ptr = priv->sq_ptr;
+    } else {
+        priv->cq_ptr = mmap(NULL, priv->cq_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, priv->ring_fd, IORING_OFF_CQ_RING);
+        if (priv->cq_ptr == MAP_FAILED) {
+            priv->cq_ptr = NULL;
+            goto failed;
+        }
+    }
+
+    priv->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    priv->sqes = mmap(NULL, priv->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      priv->ring_fd, IORING_OFF_SQES);
+    if (priv->sqes == MAP_FAILED) {
+        priv->sqes = NULL;
+        goto failed;
+    }
+
+    sq_ptr = priv->sq_ptr;
+    priv->sq_head = (unsigned int *)(sq_ptr + params.sq_off.head);
+    priv->sq_tail = (unsigned int *)(sq_ptr + params.sq_off.tail);
+    priv->sq_mask = *(unsigned int *)(sq_ptr + params.sq_off.ring_mask);
+    priv->sq_entries = *(unsigned int *)(sq_ptr + params.sq_off.ring_entries);
+    priv->sq_array = (unsigned int *)(sq_ptr + params.sq_off.array);
+
+    cq_ptr = priv->cq_ptr;
+    priv->cq_head = (unsigned int *)(cq_ptr + params.cq_off.head);
+    priv->cq_tail = (unsigned int *)(cq_ptr + params.cq_off.tail);
+    priv->cq_mask = *(unsigned int *)(cq_ptr + params.cq_off.ring_mask);
+    priv->cqes = (struct io_uring_cqe *)(cq_ptr + params.cq_off.cqes);
+
+    priv->uring = TRUE;
+
+    return TRUE;
+failed:
+    engine_release_ring(priv);
+    return FALSE;
+}
+
+static int engine_submit(ALSASeqClientEnginePrivate *priv)
+{
+    while (priv->to_submit > 0) {
+        int ret = syscall(__NR_io_uring_enter, priv->ring_fd, priv->to_submit, 0, 0, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return -errno;
+        }
+        if (ret == 0)
+            break;
+        priv->to_submit -= ret;
+    }
+
+    return 0;
+}
+
+// Reserve the given number of entries in submission queue, then return the first entry.
+static struct io_uring_sqe *engine_reserve_sqes(ALSASeqClientEnginePrivate *priv,
+                                                unsigned int count)
+{
+    unsigned int tail = *priv->sq_tail;
+    unsigned int head = g_atomic_int_get((gint *)priv->sq_head);
+
+    if (tail - head + count > priv->sq_entries) {
+        if (engine_submit(priv) < 0)
+            return NULL;
+        head = g_atomic_int_get((gint *)priv->sq_head);
+        if (tail - head + count > priv->sq_entries)
+            return NULL;
+    }
+
+    return priv->sqes + (tail & priv->sq_mask);
+}
+
+static struct io_uring_sqe *engine_next_sqe(ALSASeqClientEnginePrivate *priv)
+{
+    unsigned int tail = *priv->sq_tail;
+    unsigned int index = tail & priv->sq_mask;
+    struct io_uring_sqe *sqe = priv->sqes + index;
+
+    memset(sqe, 0, sizeof(*sqe));
+    priv->sq_array[index] = index;
+
+    return sqe;
+}
+
+static void engine_commit_sqe(ALSASeqClientEnginePrivate *priv)
+{
+    g_atomic_int_set((gint *)priv->sq_tail, *priv->sq_tail + 1);
+    ++priv->to_submit;
+    ++priv->inflight;
+}
+
+static gboolean engine_arm_read(ALSASeqClientEnginePrivate *priv, EngineEntry *entry)
+{
+    struct io_uring_sqe *sqe;
+
+    if (engine_reserve_sqes(priv, 2) == NULL)
+        return FALSE;
+
+    // The read is linked to the poll so that it works for the file descriptor opened with
+    // O_NONBLOCK as well.
+    sqe = engine_next_sqe(priv);
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = entry->fd;
+    sqe->poll32_events = POLLIN;
+    sqe->flags = IOSQE_IO_LINK;
+    sqe->user_data = ENCODE_USER_DATA(entry, ENGINE_OP_POLL);
+    engine_commit_sqe(priv);
+
+    sqe = engine_next_sqe(priv);
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = entry->fd;
+    sqe->addr = (__u64)(guintptr)entry->buf;
+    sqe->len = entry->buf_len;
+    sqe->off = (__u64)-1;
+    sqe->user_data = ENCODE_USER_DATA(entry, ENGINE_OP_READ);
+    engine_commit_sqe(priv);
+
+    return TRUE;
+}
+
+static void engine_queue_writes(ALSASeqClientEnginePrivate *priv)
+{
+    guint i;
+
+    for (i = 0; i < priv->entries->len; ++i) {
+        EngineEntry *entry = g_ptr_array_index(priv->entries, i);
+        struct io_uring_sqe *sqe;
+
+        // Keep the order of events by single request in flight for each client.
+        if (entry->inflight != NULL || entry->pending->len == 0)
+            continue;
+
+        if (engine_reserve_sqes(priv, entry->write_blocked ? 2 : 1) == NULL)
+            break;
+
+        entry->inflight_len = entry->pending->len;
+        entry->inflight = g_byte_array_free(entry->pending, FALSE);
+        entry->pending = g_byte_array_new();
+
+        // The write is retried after the poll reports room in the memory pool of client so that
+        // the submission is not repeated in each iteration while the pool is full.
+        if (entry->write_blocked) {
+            sqe = engine_next_sqe(priv);
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = entry->fd;
+            sqe->poll32_events = POLLOUT;
+            sqe->flags = IOSQE_IO_LINK;
+            sqe->user_data = ENCODE_USER_DATA(entry, ENGINE_OP_POLL_OUT);
+            engine_commit_sqe(priv);
+            entry->write_blocked = FALSE;
+        }
+
+        sqe = engine_next_sqe(priv);
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = entry->fd;
+        sqe->addr = (__u64)(guintptr)entry->inflight;
+        sqe->len = entry->inflight_len;
+        sqe->off = (__u64)-1;
+        sqe->user_data = ENCODE_USER_DATA(entry, ENGINE_OP_WRITE);
+        engine_commit_sqe(priv);
+    }
+}
+
+static gboolean engine_has_completion(ALSASeqClientEnginePrivate *priv)
+{
+    return *priv->cq_head != (unsigned int)g_atomic_int_get((gint *)priv->cq_tail);
+}
+
+static void engine_report_error(ALSASeqClientEngine *self, EngineEntry *entry, int err,
+                                const char *label)
+{
+    GError *error = NULL;
+
+    generate_syscall_error(&error, err, "io_uring(%s)", label);
+    g_signal_emit(self, seq_client_engine_sigs[SEQ_CLIENT_ENGINE_SIG_TYPE_CLIENT_ERROR], 0,
+                  entry->client, error);
+    g_error_free(error);
+}
+
+// The read for the client is not requested anymore once it fails.
+static void engine_fail_read(ALSASeqClientEngine *self, EngineEntry *entry, int err,
+                             const char *label)
+{
+    if (entry->failed)
+        return;
+    entry->failed = TRUE;
+
+    engine_report_error(self, entry, err, label);
+}
+
+static void engine_handle_completion(ALSASeqClientEngine *self, EngineEntry *entry,
+                                     unsigned int op, int res)
+{
+    ALSASeqClientEnginePrivate *priv = alsaseq_client_engine_get_instance_private(self);
+
+    switch (op) {
+    case ENGINE_OP_POLL:
+        if (res < 0 && res != -ECANCELED)
+            engine_fail_read(self, entry, -res, "poll");
+        break;
+    case ENGINE_OP_POLL_OUT:
+        // The linked write is canceled, then retried without the poll.
+        if (res < 0 && res != -ECANCELED)
+            engine_report_error(self, entry, -res, "poll");
+        break;
+    case ENGINE_OP_READ:
+        if (res > 0) {
+            ALSASeqEventCntr ev_cntr = { 0 };
+
+            // NOTE: The buffer is flatten layout.
+            ev_cntr.buf = entry->buf;
+            ev_cntr.length = res;
+            ev_cntr.aligned = TRUE;
+
+            seq_user_client_emit_event_cntr(entry->client, &ev_cntr);
+        } else if (res < 0 && res != -EAGAIN && res != -EINTR && res != -ECANCELED) {
+            engine_fail_read(self, entry, -res, "read");
+        }
+
+        if (!entry->failed && !engine_arm_read(priv, entry))
+            engine_fail_read(self, entry, EBUSY, "read");
+        break;
+    case ENGINE_OP_WRITE:
+    {
+        gsize written;
+
+        if (res == -EAGAIN) {
+            // The memory pool of client is full. Wait for room by the poll.
+            entry->write_blocked = TRUE;
+            written = 0;
+        } else if (res == -EINTR || res == -ECANCELED) {
+            written = 0;
+        } else if (res < 0) {
+            // ALSA Sequencer core writes events one by one, thus the first event fails. It is
+            // dropped so that the rest of events are not blocked by it.
+            ++priv->write_error_count;
+            written = seq_event_calculate_flattened_length((ALSASeqEvent *)entry->inflight,
+                                                           FALSE);
+            engine_report_error(self, entry, -res, "write");
+        } else {
+            written = res;
+        }
+
+        // Write the rest at first in next request.
+        if (written < entry->inflight_len) {
+            g_byte_array_prepend(entry->pending, entry->inflight + written,
+                                 entry->inflight_len - written);
+        }
+        g_free(entry->inflight);
+        entry->inflight = NULL;
+        entry->inflight_len = 0;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// Cancel the requests in flight, then wait for all of completions so that the buffers are not
+// used by the kernel after released.
+static void engine_cancel_requests(ALSASeqClientEnginePrivate *priv)
+{
+    guint i;
+
+    for (i = 0; i < priv->entries->len; ++i) {
+        EngineEntry *entry = g_ptr_array_index(priv->entries, i);
+        unsigned int ops[] = { ENGINE_OP_POLL, ENGINE_OP_READ, ENGINE_OP_POLL_OUT };
+        guint j;
+
+        if (engine_reserve_sqes(priv, G_N_ELEMENTS(ops)) == NULL)
+            break;
+
+        // The request not in flight is reported with ENOENT.
+        for (j = 0; j < G_N_ELEMENTS(ops); ++j) {
+            struct io_uring_sqe *sqe = engine_next_sqe(priv);
+
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = ENCODE_USER_DATA(entry, ops[j]);
+            sqe->user_data = ENCODE_USER_DATA(entry, ENGINE_OP_CANCEL);
+            engine_commit_sqe(priv);
+        }
+    }
+
+    while (priv->inflight > 0) {
+        unsigned int head = *priv->cq_head;
+        unsigned int tail = g_atomic_int_get((gint *)priv->cq_tail);
+        int ret;
+
+        if (head != tail) {
+            priv->inflight -= tail - head;
+            g_atomic_int_set((gint *)priv->cq_head, tail);
+            continue;
+        }
+
+        ret = syscall(__NR_io_uring_enter, priv->ring_fd, priv->to_submit, 1,
+                      IORING_ENTER_GETEVENTS, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        priv->to_submit -= MIN((unsigned int)ret, priv->to_submit);
+    }
+}
+
+static void seq_client_engine_get_property(GObject *obj, guint id, GValue *val, GParamSpec *spec)
+{
+    ALSASeqClientEngine *self = ALSASEQ_CLIENT_ENGINE(obj);
+    ALSASeqClientEnginePrivate *priv = alsaseq_client_engine_get_instance_private(self);
+
+    switch (id) {
+    case SEQ_CLIENT_ENGINE_PROP_IO_URING:
+        g_value_set_boolean(val, priv->uring);
+        break;
+    case SEQ_CLIENT_ENGINE_PROP_WRITE_ERROR_COUNT:
+        g_value_set_uint64(val, priv->write_error_count);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void seq_client_engine_finalize(GObject *obj)
+{
+    ALSASeqClientEngine *self = ALSASEQ_CLIENT_ENGINE(obj);
+    ALSASeqClientEnginePrivate *priv = alsaseq_client_engine_get_instance_private(self);
+
+    if (priv->uring)
+        engine_cancel_requests(priv);
+    engine_release_ring(priv);
+    g_ptr_array_unref(priv->entries);
+
+    G_OBJECT_CLASS(alsaseq_client_engine_parent_class)->finalize(obj);
+}
+
+static void alsaseq_client_engine_class_init(ALSASeqClientEngineClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = seq_client_engine_finalize;
+    gobject_class->get_property = seq_client_engine_get_property;
+
+    /**
+     * ALSASeqClientEngine:io-uring:
+     *
+     * Whether io_uring is used for the source created by [method@ClientEngine.create_source].
+     */
+    seq_client_engine_props[SEQ_CLIENT_ENGINE_PROP_IO_URING] =
+        g_param_spec_boolean("io-uring", "io-uring",
+                             "Whether io_uring is used.",
+                             FALSE,
+                             G_PARAM_READABLE);
+
+    /**
+     * ALSASeqClientEngine:write-error-count:
+     *
+     * The number of requests to write events which failed in io_uring.
+     */
+    seq_client_engine_props[SEQ_CLIENT_ENGINE_PROP_WRITE_ERROR_COUNT] =
+        g_param_spec_uint64("write-error-count", "write-error-count",
+                            "The number of requests to write events which failed in io_uring",
+                            0, G_MAXUINT64,
+                            0,
+                            G_PARAM_READABLE);
+
+    g_object_class_install_properties(gobject_class, SEQ_CLIENT_ENGINE_PROP_COUNT,
+                                      seq_client_engine_props);
+
+    /**
+     * ALSASeqClientEngine::client-error:
+     * @self: A [class@ClientEngine].
+     * @client: The [class@UserClient] for which the request fails.
+     * @error: A [struct@GLib.Error] with domain of `ALSASeq.UserClientError`.
+     *
+     * When the request to read or write events for the client fails in io_uring, this signal is
+     * emit. After the failure of read, the events are not read from the client anymore. After
+     * the failure of write, the first event in the request is dropped and the rest of events are
+     * written in next request. When `io_uring_enter(2)` fails, the signal is emit for all of
+     * clients, then the source is removed.
+     */
+    seq_client_engine_sigs[SEQ_CLIENT_ENGINE_SIG_TYPE_CLIENT_ERROR] =
+        g_signal_new("client-error",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqClientEngineClass, client_error),
+                     NULL, NULL,
+                     g_cclosure_marshal_generic,
+                     G_TYPE_NONE, 2, ALSASEQ_TYPE_USER_CLIENT, G_TYPE_ERROR);
+}
+
+static void alsaseq_client_engine_init(ALSASeqClientEngine *self)
+{
+    ALSASeqClientEnginePrivate *priv = alsaseq_client_engine_get_instance_private(self);
+
+    priv->entries = g_ptr_array_new_with_free_func(engine_entry_free);
+    priv->ring_fd = -1;
+}
+
+/**
+ * alsaseq_client_engine_new:
+ *
+ * Allocate and return an instance of [class@ClientEngine].
+ *
+ * Returns: An instance of [class@ClientEngine].
+ */
+ALSASeqClientEngine *alsaseq_client_engine_new()
+{
+    return g_object_new(ALSASEQ_TYPE_CLIENT_ENGINE, NULL);
+}
+
+/**
+ * alsaseq_client_engine_add_client:
+ * @self: A [class@ClientEngine].
+ * @client: A [class@UserClient] already opened.
+ * @buffer_size: The size of buffer to receive events in byte unit. Zero means the size of page.
+ * @error: A [struct@GLib.Error].
+ *
+ * Add the client to the engine. The client should be added before the call of
+ * [method@ClientEngine.create_source].
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_client_engine_add_client(ALSASeqClientEngine *self, ALSASeqUserClient *client,
+                                          gsize buffer_size, GError **error)
+{
+    ALSASeqClientEnginePrivate *priv;
+    EngineEntry *entry;
+    int fd;
+
+    g_return_val_if_fail(ALSASEQ_IS_CLIENT_ENGINE(self), FALSE);
+    priv = alsaseq_client_engine_get_instance_private(self);
+    g_return_val_if_fail(!priv->source_created, FALSE);
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(client), FALSE);
+    fd = seq_user_client_get_fd(client);
+    g_return_val_if_fail(fd >= 0, FALSE);
+    g_return_val_if_fail(buffer_size == 0 || buffer_size >= sizeof(struct snd_seq_event), FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (buffer_size == 0)
+        buffer_size = sysconf(_SC_PAGESIZE);
+
+    entry = g_new0(EngineEntry, 1);
+    entry->client = g_object_ref(client);
+    entry->fd = fd;
+    entry->buf = g_malloc0(buffer_size);
+    entry->buf_len = buffer_size;
+    entry->pending = g_byte_array_new();
+
+    g_ptr_array_add(priv->entries, entry);
+
+    return TRUE;
+}
+
+typedef struct {
+    GSource src;
+    ALSASeqClientEngine *self;
+    gpointer tag;
+} ClientEngineSource;
+
+static gboolean seq_client_engine_prepare_src(GSource *gsrc, gint *timeout)
+{
+    ClientEngineSource *src = (ClientEngineSource *)gsrc;
+    ALSASeqClientEnginePrivate *priv = alsaseq_client_engine_get_instance_private(src->self);
+    int err;
+
+    *timeout = -1;
+
+    // The source for each client is dispatched as child at fallback.
+    if (!priv->uring)
+        return FALSE;
+
+    // Submit all of requests queued in the iteration at once. The submission is retried in next
+    // iteration when the kernel has no room for completions.
+    engine_queue_writes(priv);
+    err = engine_submit(priv);
+    if (err < 0 && err != -EAGAIN && err != -EBUSY)
+        priv->submit_error = -err;
+
+    return priv->submit_error != 0 || engine_has_completion(priv);
+}
+
+static gboolean seq_client_engine_check_src(GSource *gsrc)
+{
+    ClientEngineSource *src = (ClientEngineSource *)gsrc;
+    ALSASeqClientEnginePrivate *priv = alsaseq_client_engine_get_instance_private(src->self);
+    GIOCondition condition;
+
+    if (!priv->uring)
+        return FALSE;
+
+    condition = g_source_query_unix_fd(gsrc, src->tag);
+    return priv->submit_error != 0 || engine_has_completion(priv) || !!(condition & G_IO_ERR);
+}
+
+static gboolean seq_client_engine_dispatch_src(GSource *gsrc, GSourceFunc cb, gpointer user_data)
+{
+    ClientEngineSource *src = (ClientEngineSource *)gsrc;
+    ALSASeqClientEngine *self = src->self;
+    ALSASeqClientEnginePrivate *priv = alsaseq_client_engine_get_instance_private(self);
+    unsigned int head;
+    unsigned int tail;
+
+    if (!priv->uring)
+        return G_SOURCE_CONTINUE;
+
+    if (priv->submit_error != 0) {
+        guint i;
+
+        for (i = 0; i < priv->entries->len; ++i) {
+            EngineEntry *entry = g_ptr_array_index(priv->entries, i);
+
+            engine_report_error(self, entry, priv->submit_error, "submit");
+        }
+
+        return G_SOURCE_REMOVE;
+    }
+
+    if (g_source_query_unix_fd(gsrc, src->tag) & G_IO_ERR)
+        return G_SOURCE_REMOVE;
+
+    head = *priv->cq_head;
+    tail = g_atomic_int_get((gint *)priv->cq_tail);
+    while (head != tail) {
+        const struct io_uring_cqe *cqe = priv->cqes + (head & priv->cq_mask);
+        __u64 user_data = cqe->user_data;
+        int res = cqe->res;
+
+        ++head;
+        g_atomic_int_set((gint *)priv->cq_head, head);
+        --priv->inflight;
+
+        engine_handle_completion(self, DECODE_ENTRY(user_data), DECODE_OP(user_data), res);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void seq_client_engine_finalize_src(GSource *gsrc)
+{
+    ClientEngineSource *src = (ClientEngineSource *)gsrc;
+
+    g_object_unref(src->self);
+}
+
+/**
+ * alsaseq_client_engine_create_source:
+ * @self: A [class@ClientEngine].
+ * @gsrc: (out): A #GSource to handle events for all of clients in the engine.
+ * @error: A [struct@GLib.Error].
+ *
+ * Allocate [struct@GLib.Source] structure to handle events for all of clients added to the
+ * engine. The io_uring is set up at the call when it is available, and
+ * [property@ClientEngine:io-uring] is updated. Else the source created by
+ * [method@UserClient.create_source_full] for each client is added as child source, thus the
+ * output queue, the statistics, and the error of each client are handled by it.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_client_engine_create_source(ALSASeqClientEngine *self, GSource **gsrc,
+                                             GError **error)
+{
+    static GSourceFuncs funcs = {
+            .prepare        = seq_client_engine_prepare_src,
+            .check          = seq_client_engine_check_src,
+            .dispatch       = seq_client_engine_dispatch_src,
+            .finalize       = seq_client_engine_finalize_src,
+    };
+    ALSASeqClientEnginePrivate *priv;
+    ClientEngineSource *src;
+    guint i;
+
+    g_return_val_if_fail(ALSASEQ_IS_CLIENT_ENGINE(self), FALSE);
+    priv = alsaseq_client_engine_get_instance_private(self);
+    g_return_val_if_fail(!priv->source_created, FALSE);
+
+    g_return_val_if_fail(gsrc != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    // Fall back to poll(2) when io_uring is not available.
+    if (engine_setup_ring(priv)) {
+        for (i = 0; i < priv->entries->len; ++i) {
+            EngineEntry *entry = g_ptr_array_index(priv->entries, i);
+
+            if (!engine_arm_read(priv, entry)) {
+                engine_release_ring(priv);
+                break;
+            }
+        }
+    }
+
+    *gsrc = g_source_new(&funcs, sizeof(*src));
+    src = (ClientEngineSource *)(*gsrc);
+
+    g_source_set_name(*gsrc, "ALSASeqClientEngine");
+    g_source_set_priority(*gsrc, G_PRIORITY_HIGH_IDLE);
+    g_source_set_can_recurse(*gsrc, TRUE);
+
+    src->self = g_object_ref(self);
+    if (priv->uring) {
+        src->tag = g_source_add_unix_fd(*gsrc, priv->ring_fd, G_IO_IN);
+    } else {
+        for (i = 0; i < priv->entries->len; ++i) {
+            EngineEntry *entry = g_ptr_array_index(priv->entries, i);
+            GSource *child;
+
+            if (!alsaseq_user_client_create_source_full(entry->client, entry->buf_len,
+                                                        FALLBACK_MAX_READS, &child, error)) {
+                g_source_unref(*gsrc);
+                *gsrc = NULL;
+                return FALSE;
+            }
+
+            g_source_add_child_source(*gsrc, child);
+            g_source_unref(child);
+        }
+    }
+
+    priv->source_created = TRUE;
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_client_engine_schedule_event_cntr:
+ * @self: A [class@ClientEngine].
+ * @client: A [class@UserClient] added to the engine.
+ * @ev_cntr: A [struct@EventCntr] composed by the append functions.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Schedule the batch of events for the client. When io_uring is used, the events are copied and
+ * written by the request submitted together with the other requests in next iteration of
+ * [struct@GLib.MainContext] or at the call of [method@ClientEngine.flush]. The order of events is
+ * kept for each client. Else the call is equivalent to [method@UserClient.schedule_event_cntr].
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_client_engine_schedule_event_cntr(ALSASeqClientEngine *self,
+                                                   ALSASeqUserClient *client,
+                                                   const ALSASeqEventCntr *ev_cntr,
+                                                   GError **error)
+{
+    ALSASeqClientEnginePrivate *priv;
+    EngineEntry *entry = NULL;
+    guint i;
+
+    g_return_val_if_fail(ALSASEQ_IS_CLIENT_ENGINE(self), FALSE);
+    priv = alsaseq_client_engine_get_instance_private(self);
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(client), FALSE);
+    g_return_val_if_fail(ev_cntr != NULL, FALSE);
+    g_return_val_if_fail(!ev_cntr->aligned, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (!priv->uring) {
+        gsize count;
+
+        return alsaseq_user_client_schedule_event_cntr(client, ev_cntr, &count, error);
+    }
+
+    for (i = 0; i < priv->entries->len; ++i) {
+        EngineEntry *e = g_ptr_array_index(priv->entries, i);
+
+        if (e->client == client) {
+            entry = e;
+            break;
+        }
+    }
+    g_return_val_if_fail(entry != NULL, FALSE);
+
+    g_byte_array_append(entry->pending, ev_cntr->buf, ev_cntr->length);
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_client_engine_flush:
+ * @self: A [class@ClientEngine].
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
+ *
+ * Submit the requests to write events scheduled by [method@ClientEngine.schedule_event_cntr]
+ * without waiting for next iteration of [struct@GLib.MainContext]. Nothing is done when io_uring
+ * is not used.
+ *
+ * The call of function executes `io_uring_enter(2)` system call.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_client_engine_flush(ALSASeqClientEngine *self, GError **error)
+{
+    ALSASeqClientEnginePrivate *priv;
+    int err;
+
+    g_return_val_if_fail(ALSASEQ_IS_CLIENT_ENGINE(self), FALSE);
+    priv = alsaseq_client_engine_get_instance_private(self);
+
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (!priv->uring)
+        return TRUE;
+
+    engine_queue_writes(priv);
+    err = engine_submit(priv);
+    if (err < 0) {
+        generate_syscall_error(error, -err, "io_uring_enter(%s)", "submit");
+        return FALSE;
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_CLIENT_ENGINE_H__
+#define __ALSA_GOBJECT_ALSASEQ_CLIENT_ENGINE_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_CLIENT_ENGINE   (alsaseq_client_engine_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(ALSASeqClientEngine, alsaseq_client_engine, ALSASEQ, CLIENT_ENGINE,
+                         GObject);
+
+struct _ALSASeqClientEngineClass {
+    GObjectClass parent_class;
+
+    /**
+     * ALSASeqClientEngineClass::client_error:
+     * @self: A [class@ClientEngine].
+     * @client: The [class@UserClient] for which the request fails.
+     * @error: A [struct@GLib.Error] with domain of `ALSASeq.UserClientError`.
+     *
+     * When the request to read or write events for the client fails, this signal is emit.
+     */
+    void (*client_error)(ALSASeqClientEngine *self, ALSASeqUserClient *client,
+                         const GError *error);
+};
+
+ALSASeqClientEngine *alsaseq_client_engine_new();
+
+gboolean alsaseq_client_engine_add_client(ALSASeqClientEngine *self, ALSASeqUserClient *client,
+                                          gsize buffer_size, GError **error);
+
+gboolean alsaseq_client_engine_create_source(ALSASeqClientEngine *self, GSource **gsrc,
+                                             GError **error);
+
+gboolean alsaseq_client_engine_schedule_event_cntr(ALSASeqClientEngine *self,
+                                                   ALSASeqUserClient *client,
+                                                   const ALSASeqEventCntr *ev_cntr,
+                                                   GError **error);
+
+gboolean alsaseq_client_engine_flush(ALSASeqClientEngine *self, GError **error);
+
+G_END_DECLS
+
+#endif
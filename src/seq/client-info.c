@@ -260,7 +260,8 @@ ALSASeqClientInfo *alsaseq_client_info_new()
  * @event_type_count: The number of elements for the type of event.
  * @error: A [struct@GLib.Error].
  *
- * Set the list of type of events configured to be listen.
+ * Set the list of type of events configured to be listen. The filter is available when
+ * [property@ClientInfo:use-filter] is enabled.
  *
  * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
  */
@@ -269,7 +270,6 @@ gboolean alsaseq_client_info_set_event_filter(ALSASeqClientInfo *self,
                                               gsize event_type_count, GError **error)
 {
     ALSASeqClientInfoPrivate *priv;
-    int i;
 
     g_return_val_if_fail(ALSASEQ_IS_CLIENT_INFO(self), FALSE);
     priv = alsaseq_client_info_get_instance_private(self);
@@ -277,18 +277,84 @@ gboolean alsaseq_client_info_set_event_filter(ALSASeqClientInfo *self,
     g_return_val_if_fail(event_types != NULL, FALSE);
     g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-    memset(priv->info.event_filter, 0, sizeof(priv->info.event_filter));
+    seq_client_info_fill_event_filter(&priv->info, event_types, event_type_count);
 
-    for (i = 0; i < event_type_count; ++i) {
-        ALSASeqEventType event_type = (int)event_types[i];
-        unsigned int order = event_type / (sizeof(priv->info.event_filter[0]) * 8);
-        unsigned int idx = event_type % (sizeof(priv->info.event_filter[0]) * 8);
+    return TRUE;
+}
 
-        if (order < G_N_ELEMENTS(priv->info.event_filter))
-            priv->info.event_filter[order] |= 1u << idx;
-    }
+/**
+ * alsaseq_client_info_add_event_filter:
+ * @self: A [class@ClientInfo].
+ * @event_type: A [enum@EventType] to listen.
+ *
+ * Add the type of event to the filter configured to be listen. The other types of event in the
+ * filter are kept.
+ */
+void alsaseq_client_info_add_event_filter(ALSASeqClientInfo *self, ALSASeqEventType event_type)
+{
+    ALSASeqClientInfoPrivate *priv;
+    unsigned int order;
+    unsigned int idx;
 
-    return TRUE;
+    g_return_if_fail(ALSASEQ_IS_CLIENT_INFO(self));
+    priv = alsaseq_client_info_get_instance_private(self);
+
+    order = event_type / (sizeof(priv->info.event_filter[0]) * 8);
+    idx = event_type % (sizeof(priv->info.event_filter[0]) * 8);
+    g_return_if_fail(order < G_N_ELEMENTS(priv->info.event_filter));
+
+    priv->info.event_filter[order] |= 1u << idx;
+}
+
+/**
+ * alsaseq_client_info_remove_event_filter:
+ * @self: A [class@ClientInfo].
+ * @event_type: A [enum@EventType] not to listen.
+ *
+ * Remove the type of event from the filter configured to be listen. The other types of event in
+ * the filter are kept.
+ */
+void alsaseq_client_info_remove_event_filter(ALSASeqClientInfo *self, ALSASeqEventType event_type)
+{
+    ALSASeqClientInfoPrivate *priv;
+    unsigned int order;
+    unsigned int idx;
+
+    g_return_if_fail(ALSASEQ_IS_CLIENT_INFO(self));
+    priv = alsaseq_client_info_get_instance_private(self);
+
+    order = event_type / (sizeof(priv->info.event_filter[0]) * 8);
+    idx = event_type % (sizeof(priv->info.event_filter[0]) * 8);
+    g_return_if_fail(order < G_N_ELEMENTS(priv->info.event_filter));
+
+    priv->info.event_filter[order] &= ~(1u << idx);
+}
+
+/**
+ * alsaseq_client_info_check_event_filter:
+ * @self: A [class@ClientInfo].
+ * @event_type: A [enum@EventType].
+ * @listen: (out): Whether the type of event is in the filter configured to be listen.
+ *
+ * Check whether the type of event is in the filter configured to be listen.
+ */
+void alsaseq_client_info_check_event_filter(ALSASeqClientInfo *self, ALSASeqEventType event_type,
+                                            gboolean *listen)
+{
+    ALSASeqClientInfoPrivate *priv;
+    unsigned int order;
+    unsigned int idx;
+
+    g_return_if_fail(ALSASEQ_IS_CLIENT_INFO(self));
+    priv = alsaseq_client_info_get_instance_private(self);
+
+    g_return_if_fail(listen != NULL);
+
+    order = event_type / (sizeof(priv->info.event_filter[0]) * 8);
+    idx = event_type % (sizeof(priv->info.event_filter[0]) * 8);
+    g_return_if_fail(order < G_N_ELEMENTS(priv->info.event_filter));
+
+    *listen = !!(priv->info.event_filter[order] & (1u << idx));
 }
 
 /**
@@ -354,6 +420,23 @@ gboolean alsaseq_client_info_get_event_filter(ALSASeqClientInfo *self,
     return TRUE;
 }
 
+void seq_client_info_fill_event_filter(struct snd_seq_client_info *info,
+                                       const ALSASeqEventType *event_types, gsize event_type_count)
+{
+    int i;
+
+    memset(info->event_filter, 0, sizeof(info->event_filter));
+
+    for (i = 0; i < event_type_count; ++i) {
+        ALSASeqEventType event_type = (int)event_types[i];
+        unsigned int order = event_type / (sizeof(info->event_filter[0]) * 8);
+        unsigned int idx = event_type % (sizeof(info->event_filter[0]) * 8);
+
+        if (order < G_N_ELEMENTS(info->event_filter))
+            info->event_filter[order] |= 1u << idx;
+    }
+}
+
 void seq_client_info_refer_private(ALSASeqClientInfo *self,
                                    struct snd_seq_client_info **info)
 {
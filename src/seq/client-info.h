@@ -20,6 +20,13 @@ gboolean alsaseq_client_info_set_event_filter(ALSASeqClientInfo *self,
                                               const ALSASeqEventType *event_types,
                                               gsize event_type_count, GError **error);
 
+void alsaseq_client_info_add_event_filter(ALSASeqClientInfo *self, ALSASeqEventType event_type);
+
+void alsaseq_client_info_remove_event_filter(ALSASeqClientInfo *self, ALSASeqEventType event_type);
+
+void alsaseq_client_info_check_event_filter(ALSASeqClientInfo *self, ALSASeqEventType event_type,
+                                            gboolean *listen);
+
 gboolean alsaseq_client_info_get_event_filter(ALSASeqClientInfo *self,
                                               ALSASeqEventType **event_types,
                                               gsize *event_type_count, GError **error);
@@ -7,6 +7,23 @@
  *
  * For batch of events, [struct@EventCntr] keeps flatten buffer which serialize the events without
  * pointing to extra data blob for variable type.
+ *
+ * The call of [method@EventCntr.get_event] refers to the event in the buffer without copying it,
+ * while the call of [method@EventCntr.deserialize] duplicates all of events. The position of
+ * event referred at last is cached, thus the events are referred in order of index without
+ * iteration from the beginning of buffer.
+ *
+ * The container allocated by [ctor@EventCntr.new] is available to compose batch of events to be
+ * scheduled by [method@UserClient.schedule_event_cntr]. Each call of the append functions writes
+ * the event into the flattened buffer directly, and the buffer grows when the reserved space is
+ * not enough.
+ *
+ * The copy of container shares the flattened buffer by [struct@GLib.Bytes] with reference count
+ * when the buffer is already shared. Otherwise the buffer is duplicated into new
+ * [struct@GLib.Bytes] for the copy. The container given by [signal@UserClient::handle-event]
+ * signal refers to the buffer to read events, thus each copy of it duplicates the buffer, while
+ * the copy of the copy shares the duplicated one. The shared buffer is duplicated again when any
+ * event is appended to the container.
  */
 
 static ALSASeqEventCntr *seq_event_cntr_copy(const ALSASeqEventCntr *src)
@@ -16,20 +33,119 @@ static ALSASeqEventCntr *seq_event_cntr_copy(const ALSASeqEventCntr *src)
     dst = g_malloc0(sizeof(*dst));
     memcpy(dst, src, sizeof(*dst));
 
-    dst->buf = g_malloc0(src->length);
-    memcpy(dst->buf, src->buf, src->length);
+    if (src->bytes != NULL) {
+        dst->bytes = g_bytes_ref(src->bytes);
+    } else {
+        dst->bytes = g_bytes_new(src->buf, src->length);
+        dst->buf = (guint8 *)g_bytes_get_data(dst->bytes, NULL);
+    }
+    dst->capacity = src->length;
 
     return dst;
 }
 
 static void seq_event_cntr_free(ALSASeqEventCntr *self)
 {
-    g_free(self->buf);
+    if (self->bytes != NULL)
+        g_bytes_unref(self->bytes);
+    else
+        g_free(self->buf);
     g_free(self);
 }
 
+// Release the shared buffer. The content is duplicated when required.
+static void seq_event_cntr_detach(ALSASeqEventCntr *self, gboolean keep)
+{
+    guint8 *buf = NULL;
+
+    if (keep && self->length > 0) {
+        buf = g_malloc(self->length);
+        memcpy(buf, self->buf, self->length);
+    }
+
+    g_bytes_unref(self->bytes);
+    self->bytes = NULL;
+    self->buf = buf;
+    self->capacity = buf != NULL ? self->length : 0;
+    if (buf == NULL)
+        self->cursor = 0;
+}
+
 G_DEFINE_BOXED_TYPE(ALSASeqEventCntr, alsaseq_event_cntr, seq_event_cntr_copy, seq_event_cntr_free);
 
+/**
+ * alsaseq_event_cntr_new:
+ * @reserved: The size of flattened buffer reserved in advance, in byte unit.
+ *
+ * Allocate and return an instance of [struct@EventCntr] to compose batch of events.
+ *
+ * Returns: An instance of [struct@EventCntr].
+ */
+ALSASeqEventCntr *alsaseq_event_cntr_new(gsize reserved)
+{
+    ALSASeqEventCntr *self;
+
+    self = g_malloc0(sizeof(*self));
+    if (reserved > 0)
+        self->buf = g_malloc0(reserved);
+    self->capacity = reserved;
+
+    return self;
+}
+
+/**
+ * alsaseq_event_cntr_new_from_bytes:
+ * @bytes: A [struct@GLib.Bytes] including flattened events.
+ * @aligned: Whether the events have the aligned layout as the ones retrieved by `read(2)`.
+ *
+ * Allocate and return an instance of [struct@EventCntr] which refers to the flattened events in
+ * the bytes without copying them. The content of [struct@GLib.MappedFile] is available without
+ * copying by [method@GLib.MappedFile.get_bytes]. The events are available to be scheduled by
+ * [method@UserClient.schedule_event_cntr] when they have the layout without alignment.
+ *
+ * Returns: An instance of [struct@EventCntr].
+ */
+ALSASeqEventCntr *alsaseq_event_cntr_new_from_bytes(GBytes *bytes, gboolean aligned)
+{
+    ALSASeqEventCntr *self;
+    gsize length;
+
+    g_return_val_if_fail(bytes != NULL, NULL);
+
+    self = g_malloc0(sizeof(*self));
+    self->bytes = g_bytes_ref(bytes);
+    self->buf = (guint8 *)g_bytes_get_data(bytes, &length);
+    self->length = length;
+    self->aligned = aligned;
+    self->capacity = length;
+
+    return self;
+}
+
+/**
+ * alsaseq_event_cntr_get_bytes:
+ * @self: A [struct@EventCntr].
+ * @bytes: (out) (transfer full): A [struct@GLib.Bytes] including flattened events.
+ * @aligned: (out): Whether the events have the aligned layout as the ones retrieved by `read(2)`.
+ *
+ * Retrieve the flattened events as [struct@GLib.Bytes]. When the container shares the buffer
+ * by the copy of container or [ctor@EventCntr.new_from_bytes], the reference count is just
+ * increased, else the flattened events are duplicated.
+ */
+void alsaseq_event_cntr_get_bytes(const ALSASeqEventCntr *self, GBytes **bytes,
+                                  gboolean *aligned)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(bytes != NULL);
+    g_return_if_fail(aligned != NULL);
+
+    if (self->bytes != NULL)
+        *bytes = g_bytes_ref(self->bytes);
+    else
+        *bytes = g_bytes_new(self->buf, self->length);
+    *aligned = self->aligned;
+}
+
 struct seq_event_iter {
     guint8 *buf;
     gsize length;
@@ -66,7 +182,10 @@ static struct snd_seq_event *seq_event_iter_next(struct seq_event_iter *iter)
     return NULL;
 }
 
-void seq_event_cntr_serialize(ALSASeqEventCntr *self, const GList *events, gboolean aligned)
+// The variable length event is converted to the event with pointer to the blob when the function
+// returns TRUE for it. NULL means no conversion.
+void seq_event_cntr_serialize(ALSASeqEventCntr *self, const GList *events, gboolean aligned,
+                              SeqEventPointerDataFunc to_pointer, gpointer user_data)
 {
     const GList *entry;
     gsize total_length;
@@ -76,6 +195,10 @@ void seq_event_cntr_serialize(ALSASeqEventCntr *self, const GList *events, gbool
     g_return_if_fail(self != NULL);
     g_return_if_fail(events != NULL);
 
+    if (self->bytes != NULL)
+        seq_event_cntr_detach(self, FALSE);
+    self->cursor = 0;
+
     // Calculate total length of flattened events.
     total_length = 0;
     for (entry = events; entry != NULL; entry = g_list_next(entry)) {
@@ -83,14 +206,24 @@ void seq_event_cntr_serialize(ALSASeqEventCntr *self, const GList *events, gbool
 
         g_return_if_fail(ev != NULL);
 
-        total_length += seq_event_calculate_flattened_length(ev, aligned);
+        if (to_pointer != NULL && to_pointer(ev, user_data))
+            total_length += sizeof(*ev);
+        else
+            total_length += seq_event_calculate_flattened_length(ev, aligned);
     }
 
     // Nothing to do.
-    if (total_length == 0)
+    if (total_length == 0) {
+        self->length = 0;
         return;
+    }
 
-    buf = g_malloc0(total_length);
+    // Reuse the buffer when it has enough space.
+    if (total_length > self->capacity) {
+        self->buf = g_realloc(self->buf, total_length);
+        self->capacity = total_length;
+    }
+    buf = self->buf;
 
     pos = 0;
     for (entry = events; entry != NULL; entry = g_list_next(entry)) {
@@ -99,20 +232,462 @@ void seq_event_cntr_serialize(ALSASeqEventCntr *self, const GList *events, gbool
 
         g_return_if_fail(ev != NULL);
 
-        length = seq_event_calculate_flattened_length(ev, aligned);
-        seq_event_copy_flattened(ev, buf + pos, length);
+        if (to_pointer != NULL && to_pointer(ev, user_data)) {
+            struct snd_seq_event *header = (struct snd_seq_event *)(buf + pos);
+
+            length = sizeof(*ev);
+            memcpy(header, ev, length);
+            header->flags &= ~SNDRV_SEQ_EVENT_LENGTH_MASK;
+            header->flags |= SNDRV_SEQ_EVENT_LENGTH_VARUSR;
+        } else {
+            length = seq_event_calculate_flattened_length(ev, aligned);
+            seq_event_copy_flattened(ev, buf + pos, length);
+        }
         pos += length;
     }
 
     g_return_if_fail(total_length == pos);
 
-    g_free(self->buf);
-
-    self->buf = buf;
     self->length = total_length;
     self->aligned = aligned;
 }
 
+// The cursor keeps the index of event referred at last in upper 32 bits, and its offset in lower 32
+// bits, so that the next event is found without iteration from the beginning. It is loaded and
+// stored at once since the container can be referred by several threads.
+#define CURSOR_INDEX(cursor)            ((gsize)((cursor) >> 32))
+#define CURSOR_OFFSET(cursor)           ((gsize)((cursor) & G_MAXUINT32))
+#define CURSOR_ENCODE(index, offset)    (((guint64)(index) << 32) | (offset))
+
+static const struct snd_seq_event *seq_event_cntr_find(const ALSASeqEventCntr *self, gsize index)
+{
+    guint64 cursor = __atomic_load_n(&self->cursor, __ATOMIC_RELAXED);
+    struct seq_event_iter iter;
+    struct snd_seq_event *ev;
+    gsize count;
+
+    seq_event_iter_init(&iter, self->buf, self->length, self->aligned);
+
+    // Restart from the beginning for the former event.
+    count = CURSOR_INDEX(cursor);
+    if (count <= index && CURSOR_OFFSET(cursor) < self->length)
+        iter.offset = CURSOR_OFFSET(cursor);
+    else
+        count = 0;
+
+    while ((ev = seq_event_iter_next(&iter))) {
+        if (count == index) {
+            gsize offset = (guint8 *)ev - self->buf;
+
+            if (index <= G_MAXUINT32 && offset <= G_MAXUINT32) {
+                __atomic_store_n(&((ALSASeqEventCntr *)self)->cursor,
+                                 CURSOR_ENCODE(index, offset), __ATOMIC_RELAXED);
+            }
+            return ev;
+        }
+        ++count;
+    }
+
+    return NULL;
+}
+
+/**
+ * alsaseq_event_cntr_count_events:
+ * @self: A [struct@EventCntr].
+ * @count: (out): The number of events in the container.
+ *
+ * Count the number of events in the flattened buffer.
+ */
+void alsaseq_event_cntr_count_events(const ALSASeqEventCntr *self, gsize *count)
+{
+    struct seq_event_iter iter;
+
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = 0;
+    seq_event_iter_init(&iter, self->buf, self->length, self->aligned);
+    while (seq_event_iter_next(&iter))
+        ++(*count);
+}
+
+/**
+ * alsaseq_event_cntr_extract_columns:
+ * @self: A [struct@EventCntr].
+ * @types: (array length=count)(out)(transfer full)(optional): The type of events.
+ * @times: (array length=count)(out)(transfer full)(optional): The time stamp of events; tick count
+ *         for [enum@EventTstampMode].TICK, or nanoseconds for [enum@EventTstampMode].REAL.
+ * @sources: (array length=count)(out)(transfer full)(optional): The address of source; the
+ *           numeric ID of client in upper 8 bits, and the numeric ID of port in lower 8 bits.
+ * @destinations: (array length=count)(out)(transfer full)(optional): The address of destination
+ *                with the same layout as sources.
+ * @channels: (array length=count)(out)(transfer full)(optional): The channel of note or control
+ *            data.
+ * @params: (array length=count)(out)(transfer full)(optional): The note of note data, or the
+ *          parameter of control data.
+ * @values: (array length=count)(out)(transfer full)(optional): The velocity of note data, or the
+ *          value of control data.
+ * @count: (out): The number of events in the container.
+ *
+ * Split the batch of events into parallel arrays by single pass over the flattened buffer. The
+ * channel, parameter, and value are zero for the type of event which has neither note nor control
+ * data. The arrays are allocated by the call, and should be released by [func@GLib.free].
+ */
+void alsaseq_event_cntr_extract_columns(const ALSASeqEventCntr *self, guint8 **types,
+                                        guint64 **times, guint16 **sources,
+                                        guint16 **destinations, guint8 **channels,
+                                        guint32 **params, gint32 **values, gsize *count)
+{
+    struct seq_event_iter iter;
+    const struct snd_seq_event *ev;
+    gsize index;
+
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    alsaseq_event_cntr_count_events(self, count);
+
+    if (types != NULL)
+        *types = g_new(guint8, *count);
+    if (times != NULL)
+        *times = g_new(guint64, *count);
+    if (sources != NULL)
+        *sources = g_new(guint16, *count);
+    if (destinations != NULL)
+        *destinations = g_new(guint16, *count);
+    if (channels != NULL)
+        *channels = g_new(guint8, *count);
+    if (params != NULL)
+        *params = g_new(guint32, *count);
+    if (values != NULL)
+        *values = g_new(gint32, *count);
+
+    index = 0;
+    seq_event_iter_init(&iter, self->buf, self->length, self->aligned);
+    while ((ev = seq_event_iter_next(&iter))) {
+        guint8 channel;
+        guint32 param;
+        gint32 value;
+
+        if (types != NULL)
+            (*types)[index] = ev->type;
+        if (times != NULL) {
+            if ((ev->flags & SNDRV_SEQ_TIME_STAMP_MASK) == SNDRV_SEQ_TIME_STAMP_TICK)
+                (*times)[index] = ev->time.tick;
+            else
+                (*times)[index] = (guint64)ev->time.time.tv_sec * 1000000000 +
+                                  ev->time.time.tv_nsec;
+        }
+        if (sources != NULL)
+            (*sources)[index] = (ev->source.client << 8) | ev->source.port;
+        if (destinations != NULL)
+            (*destinations)[index] = (ev->dest.client << 8) | ev->dest.port;
+
+        seq_event_extract_channel_data(ev, &channel, &param, &value);
+        if (channels != NULL)
+            (*channels)[index] = channel;
+        if (params != NULL)
+            (*params)[index] = param;
+        if (values != NULL)
+            (*values)[index] = value;
+
+        ++index;
+    }
+}
+
+/**
+ * alsaseq_event_cntr_get_event:
+ * @self: A [struct@EventCntr].
+ * @index: The index of event in the container.
+ * @event: (out) (transfer none) (nullable): The [struct@Event] in the container, or %NULL when
+ *         the index is out of range.
+ *
+ * Refer to the event at the index in the flattened buffer without any copy. The event is
+ * available as long as the container is alive. For [enum@EventLengthMode].VARIABLE type of event,
+ * the blob data should be retrieved by [method@EventCntr.get_blob_data], since the pointer in the
+ * event is not available in user space.
+ */
+void alsaseq_event_cntr_get_event(const ALSASeqEventCntr *self, gsize index,
+                                  const ALSASeqEvent **event)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(event != NULL);
+
+    *event = seq_event_cntr_find(self, index);
+}
+
+/**
+ * alsaseq_event_cntr_get_blob_data:
+ * @self: A [struct@EventCntr].
+ * @index: The index of event in the container.
+ * @data: (array length=length) (out) (transfer none): The pointer to blob data.
+ * @length: (out): The length of blob data in byte unit.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.EventError`.
+ *
+ * Refer to the blob data of [enum@EventLengthMode].VARIABLE type of event at the index, which
+ * follows the event in the flattened buffer. No copy is done. The index out of range is reported
+ * by [enum@EventError].FAILED.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_event_cntr_get_blob_data(const ALSASeqEventCntr *self, gsize index,
+                                          const guint8 **data, gsize *length, GError **error)
+{
+    const struct snd_seq_event *ev;
+
+    g_return_val_if_fail(self != NULL, FALSE);
+    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(length != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    ev = seq_event_cntr_find(self, index);
+    if (ev == NULL) {
+        g_set_error(error, ALSASEQ_EVENT_ERROR, ALSASEQ_EVENT_ERROR_FAILED,
+                    "The index of event is out of range: %lu", index);
+        return FALSE;
+    }
+
+    if ((ev->flags & SNDRV_SEQ_EVENT_LENGTH_MASK) != SNDRV_SEQ_EVENT_LENGTH_VARIABLE) {
+        g_set_error_literal(error, ALSASEQ_EVENT_ERROR, ALSASEQ_EVENT_ERROR_INVALID_LENGTH_MODE,
+                            "The mode of length for requested data is invalid in the event");
+        return FALSE;
+    }
+
+    *data = (const guint8 *)ev + sizeof(*ev);
+    *length = ev->data.ext.len;
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_event_cntr_clear:
+ * @self: A [struct@EventCntr].
+ *
+ * Discard all of events in the container. The flattened buffer is kept for reuse.
+ */
+void alsaseq_event_cntr_clear(ALSASeqEventCntr *self)
+{
+    g_return_if_fail(self != NULL);
+
+    if (self->bytes != NULL)
+        seq_event_cntr_detach(self, FALSE);
+    self->length = 0;
+    self->cursor = 0;
+}
+
+static gboolean seq_event_cntr_append(ALSASeqEventCntr *self, const struct snd_seq_event *ev,
+                                      GError **error)
+{
+    gsize length;
+
+    // NOTE: The buffer retrieved by read(2) has aligned layout, which is not acceptable for
+    // write(2).
+    g_return_val_if_fail(!self->aligned, FALSE);
+
+    if (!seq_event_is_deliverable(ev)) {
+        g_set_error_literal(error, ALSASEQ_USER_CLIENT_ERROR,
+                            ALSASEQ_USER_CLIENT_ERROR_EVENT_UNDELIVERABLE,
+                            "The operation failes due to undeliverable event");
+        return FALSE;
+    }
+
+    if (self->bytes != NULL)
+        seq_event_cntr_detach(self, TRUE);
+
+    length = seq_event_calculate_flattened_length(ev, FALSE);
+    if (self->length + length > self->capacity) {
+        gsize capacity = MAX(self->capacity, sizeof(*ev));
+
+        while (capacity < self->length + length)
+            capacity *= 2;
+
+        self->buf = g_realloc(self->buf, capacity);
+        self->capacity = capacity;
+    }
+
+    seq_event_copy_flattened(ev, self->buf + self->length, length);
+    self->length += length;
+
+    return TRUE;
+}
+
+static void seq_event_cntr_prepare_event(struct snd_seq_event *ev, const ALSASeqEvent *header,
+                                         ALSASeqEventType event_type)
+{
+    *ev = *header;
+    ev->type = event_type;
+    ev->flags &= ~SNDRV_SEQ_EVENT_LENGTH_MASK;
+    ev->flags |= SNDRV_SEQ_EVENT_LENGTH_FIXED;
+    memset(&ev->data, 0, sizeof(ev->data));
+}
+
+/**
+ * alsaseq_event_cntr_append_event:
+ * @self: A [struct@EventCntr].
+ * @event: A [struct@Event] to append.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
+ *
+ * Copy the event into the flattened buffer.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_event_cntr_append_event(ALSASeqEventCntr *self, const ALSASeqEvent *event,
+                                         GError **error)
+{
+    g_return_val_if_fail(self != NULL, FALSE);
+    g_return_val_if_fail(event != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_event_cntr_append(self, event, error);
+}
+
+/**
+ * alsaseq_event_cntr_append_note_data:
+ * @self: A [struct@EventCntr].
+ * @header: A [struct@Event] as template of the other fields than type and data.
+ * @event_type: The type of event to append.
+ * @data: The note data of event.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `ALSASeq.EventError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Append the event with the note data into the flattened buffer. The modes, tag, queue, addresses,
+ * and time stamp are copied from the header, while the type of event and the data are overwritten.
+ * The type of event should be acceptable for [method@Event.set_note_data].
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_event_cntr_append_note_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                             ALSASeqEventType event_type,
+                                             const ALSASeqEventDataNote *data, GError **error)
+{
+    struct snd_seq_event ev;
+
+    g_return_val_if_fail(self != NULL, FALSE);
+    g_return_val_if_fail(header != NULL, FALSE);
+    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    seq_event_cntr_prepare_event(&ev, header, event_type);
+    if (!alsaseq_event_set_note_data(&ev, data, error))
+        return FALSE;
+
+    return seq_event_cntr_append(self, &ev, error);
+}
+
+/**
+ * alsaseq_event_cntr_append_ctl_data:
+ * @self: A [struct@EventCntr].
+ * @header: A [struct@Event] as template of the other fields than type and data.
+ * @event_type: The type of event to append.
+ * @data: The control data of event.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `ALSASeq.EventError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Append the event with the control data into the flattened buffer. The modes, tag, queue,
+ * addresses, and time stamp are copied from the header, while the type of event and the data are
+ * overwritten. The type of event should be acceptable for [method@Event.set_ctl_data].
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_event_cntr_append_ctl_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                            ALSASeqEventType event_type,
+                                            const ALSASeqEventDataCtl *data, GError **error)
+{
+    struct snd_seq_event ev;
+
+    g_return_val_if_fail(self != NULL, FALSE);
+    g_return_val_if_fail(header != NULL, FALSE);
+    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    seq_event_cntr_prepare_event(&ev, header, event_type);
+    if (!alsaseq_event_set_ctl_data(&ev, data, error))
+        return FALSE;
+
+    return seq_event_cntr_append(self, &ev, error);
+}
+
+/**
+ * alsaseq_event_cntr_append_queue_data:
+ * @self: A [struct@EventCntr].
+ * @header: A [struct@Event] as template of the other fields than type and data.
+ * @event_type: The type of event to append.
+ * @data: The queue data of event.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `ALSASeq.EventError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Append the event with the queue data into the flattened buffer. The modes, tag, queue,
+ * addresses, and time stamp are copied from the header, while the type of event and the data are
+ * overwritten. The type of event should be acceptable for [method@Event.set_queue_data].
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_event_cntr_append_queue_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                              ALSASeqEventType event_type,
+                                              const ALSASeqEventDataQueue *data, GError **error)
+{
+    struct snd_seq_event ev;
+
+    g_return_val_if_fail(self != NULL, FALSE);
+    g_return_val_if_fail(header != NULL, FALSE);
+    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    seq_event_cntr_prepare_event(&ev, header, event_type);
+    if (!alsaseq_event_set_queue_data(&ev, data, error))
+        return FALSE;
+
+    return seq_event_cntr_append(self, &ev, error);
+}
+
+// The length field of variable length event is 32 bit, and the upper bits are reserved by ALSA
+// Sequencer core for flags; SNDRV_SEQ_EXT_MASK in kernel land.
+#define SEQ_EVENT_EXT_MASK  0xc0000000
+
+/**
+ * alsaseq_event_cntr_append_blob_data:
+ * @self: A [struct@EventCntr].
+ * @header: A [struct@Event] as template of the other fields than type and data.
+ * @event_type: The type of event to append.
+ * @data: (array length=length): The pointer to blob data for the event.
+ * @length: The length of data.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `ALSASeq.EventError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Append the event with the blob data into the flattened buffer. The modes, tag, queue,
+ * addresses, and time stamp are copied from the header, while the type of event and the data are
+ * overwritten. The blob data is copied just once into the flattened buffer. The length should not
+ * overlap the upper bits reserved by ALSA Sequencer core in the length field of event, else
+ * [enum@EventError].FAILED is reported.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_event_cntr_append_blob_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                             ALSASeqEventType event_type, const guint8 *data,
+                                             gsize length, GError **error)
+{
+    struct snd_seq_event ev;
+
+    g_return_val_if_fail(self != NULL, FALSE);
+    g_return_val_if_fail(header != NULL, FALSE);
+    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (length > G_MAXUINT32 || (length & SEQ_EVENT_EXT_MASK)) {
+        g_set_error(error, ALSASEQ_EVENT_ERROR, ALSASEQ_EVENT_ERROR_FAILED,
+                    "The length of blob data is too large: %lu", length);
+        return FALSE;
+    }
+
+    seq_event_cntr_prepare_event(&ev, header, event_type);
+    ev.flags &= ~SNDRV_SEQ_EVENT_LENGTH_MASK;
+    ev.flags |= SNDRV_SEQ_EVENT_LENGTH_VARIABLE;
+    ev.data.ext.ptr = (void *)data;
+    ev.data.ext.len = length;
+
+    return seq_event_cntr_append(self, &ev, error);
+}
+
 /**
  * alsaseq_event_cntr_deserialize:
  * @self: A [struct@EventCntr].
@@ -124,6 +699,7 @@ void alsaseq_event_cntr_deserialize(const ALSASeqEventCntr *self, GList **events
 {
     struct seq_event_iter iter;
     struct snd_seq_event *ev;
+    GList *list = NULL;
 
     seq_event_iter_init(&iter, self->buf, self->length, self->aligned);
     while ((ev = seq_event_iter_next(&iter))) {
@@ -132,6 +708,8 @@ void alsaseq_event_cntr_deserialize(const ALSASeqEventCntr *self, GList **events
         // MEMO: For [enum@EventLengthMode].VARIABLE type of event, a memory object is allocated
         // for blob data, since the size of boxed structure should have fixed size.
         event = g_boxed_copy(ALSASEQ_TYPE_EVENT, ev);
-        *events = g_list_append(*events, event);
+        list = g_list_prepend(list, event);
     }
+
+    *events = g_list_concat(*events, g_list_reverse(list));
 }
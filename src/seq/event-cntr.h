@@ -13,10 +13,54 @@ typedef struct {
     guint8 *buf;
     gsize length;
     gboolean aligned;
+    gsize capacity;
+    GBytes *bytes;
+    guint64 cursor;
 } ALSASeqEventCntr;
 
 GType alsaseq_event_cntr_get_type() G_GNUC_CONST;
 
+ALSASeqEventCntr *alsaseq_event_cntr_new(gsize reserved);
+
+ALSASeqEventCntr *alsaseq_event_cntr_new_from_bytes(GBytes *bytes, gboolean aligned);
+
+void alsaseq_event_cntr_get_bytes(const ALSASeqEventCntr *self, GBytes **bytes,
+                                  gboolean *aligned);
+
+void alsaseq_event_cntr_count_events(const ALSASeqEventCntr *self, gsize *count);
+
+void alsaseq_event_cntr_extract_columns(const ALSASeqEventCntr *self, guint8 **types,
+                                        guint64 **times, guint16 **sources,
+                                        guint16 **destinations, guint8 **channels,
+                                        guint32 **params, gint32 **values, gsize *count);
+
+void alsaseq_event_cntr_get_event(const ALSASeqEventCntr *self, gsize index,
+                                  const ALSASeqEvent **event);
+
+gboolean alsaseq_event_cntr_get_blob_data(const ALSASeqEventCntr *self, gsize index,
+                                          const guint8 **data, gsize *length, GError **error);
+
+void alsaseq_event_cntr_clear(ALSASeqEventCntr *self);
+
+gboolean alsaseq_event_cntr_append_event(ALSASeqEventCntr *self, const ALSASeqEvent *event,
+                                         GError **error);
+
+gboolean alsaseq_event_cntr_append_note_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                             ALSASeqEventType event_type,
+                                             const ALSASeqEventDataNote *data, GError **error);
+
+gboolean alsaseq_event_cntr_append_ctl_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                            ALSASeqEventType event_type,
+                                            const ALSASeqEventDataCtl *data, GError **error);
+
+gboolean alsaseq_event_cntr_append_queue_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                              ALSASeqEventType event_type,
+                                              const ALSASeqEventDataQueue *data, GError **error);
+
+gboolean alsaseq_event_cntr_append_blob_data(ALSASeqEventCntr *self, const ALSASeqEvent *header,
+                                             ALSASeqEventType event_type, const guint8 *data,
+                                             gsize length, GError **error);
+
 void alsaseq_event_cntr_deserialize(const ALSASeqEventCntr *self, GList **events);
 
 G_END_DECLS
@@ -51,11 +51,78 @@
  * The object wraps `struct snd_seq_event` in UAPI of Linux sound subsystem.
  */
 
+// The instances released in the thread are cached up to the number, then reused for the
+// allocation in the thread so that short-lived events are free from the cost of allocator.
+#define SEQ_EVENT_CACHE_MAX     256
+
+typedef struct {
+    // The instances are linked by the first bytes of them.
+    ALSASeqEvent *head;
+    guint count;
+} SeqEventCache;
+
+static void seq_event_cache_free(gpointer data)
+{
+    SeqEventCache *cache = data;
+
+    while (cache->head != NULL) {
+        ALSASeqEvent *ev = cache->head;
+
+        memcpy(&cache->head, ev, sizeof(cache->head));
+        g_free(ev);
+    }
+
+    g_free(cache);
+}
+
+// The cache is released at the exit of thread.
+static GPrivate seq_event_cache_key = G_PRIVATE_INIT(seq_event_cache_free);
+
+static SeqEventCache *seq_event_get_cache()
+{
+    SeqEventCache *cache = g_private_get(&seq_event_cache_key);
+
+    if (cache == NULL) {
+        cache = g_new0(SeqEventCache, 1);
+        g_private_set(&seq_event_cache_key, cache);
+    }
+
+    return cache;
+}
+
+static ALSASeqEvent *seq_event_alloc()
+{
+    SeqEventCache *cache = seq_event_get_cache();
+    ALSASeqEvent *ev = cache->head;
+
+    if (ev == NULL)
+        return g_malloc(sizeof(*ev));
+
+    memcpy(&cache->head, ev, sizeof(cache->head));
+    --cache->count;
+
+    return ev;
+}
+
+static void seq_event_release(ALSASeqEvent *ev)
+{
+    SeqEventCache *cache = seq_event_get_cache();
+
+    if (cache->count >= SEQ_EVENT_CACHE_MAX) {
+        g_free(ev);
+        return;
+    }
+
+    memcpy(ev, &cache->head, sizeof(cache->head));
+    cache->head = ev;
+    ++cache->count;
+}
+
 static ALSASeqEvent *seq_event_copy(const ALSASeqEvent *self)
 {
     ALSASeqEvent *ev;
 
-    ev = g_malloc0(sizeof(*ev));
+    ev = seq_event_alloc();
     memcpy(ev, self, sizeof(*ev));
 
     // NOTE: The instance of boxed structure should have the same size, thus variable length of
@@ -109,7 +176,7 @@ static void free_blob_data(ALSASeqEvent *ev)
 static void seq_event_free(ALSASeqEvent *ev)
 {
     free_blob_data(ev);
-    g_free(ev);
+    seq_event_release(ev);
 }
 
 G_DEFINE_BOXED_TYPE(ALSASeqEvent, alsaseq_event, seq_event_copy, seq_event_free);
@@ -133,11 +200,13 @@ G_DEFINE_QUARK(alsaseq-event-error-quark, alsaseq_event_error)
  */
 ALSASeqEvent *alsaseq_event_new(ALSASeqEventType event_type)
 {
-    struct snd_seq_event src = { 0 };
+    ALSASeqEvent *ev = seq_event_alloc();
 
-    src.type = event_type;
+    // The event has fixed length, thus it is not required to go through the copy function.
+    memset(ev, 0, sizeof(*ev));
+    ev->type = event_type;
 
-    return g_boxed_copy(ALSASEQ_TYPE_EVENT, &src);
+    return ev;
 }
 
 /**
@@ -1675,6 +1744,15 @@ gsize seq_event_calculate_flattened_length(const ALSASeqEvent *self, gboolean al
     return length;
 }
 
+// The blob of variable length event delivered directly can be read by ALSA Sequencer core from
+// user space during the call of write(2), instead of copying it into the flattened buffer.
+gboolean seq_event_is_pointer_data_candidate(const ALSASeqEvent *self, gsize threshold)
+{
+    return threshold > 0 &&
+           (self->flags & SNDRV_SEQ_EVENT_LENGTH_MASK) == SNDRV_SEQ_EVENT_LENGTH_VARIABLE &&
+           self->queue == SNDRV_SEQ_QUEUE_DIRECT && self->data.ext.len >= threshold;
+}
+
 gboolean seq_event_is_deliverable(const ALSASeqEvent *self)
 {
     enum seq_event_data_flag flags = seq_event_data_flags[self->type];
@@ -1700,3 +1778,28 @@ gboolean seq_event_is_deliverable(const ALSASeqEvent *self)
         return FALSE;
     }
 }
+
+// The data of note or control is extracted only for the type of event which has it exclusively.
+void seq_event_extract_channel_data(const ALSASeqEvent *self, guint8 *channel, guint32 *param,
+                                    gint32 *value)
+{
+    enum seq_event_data_flag flags = seq_event_data_flags[self->type];
+
+    switch (flags & SEQ_EVENT_DATA_FLAG_FIXED_ANY) {
+    case SEQ_EVENT_DATA_FLAG_NOTE:
+        *channel = self->data.note.channel;
+        *param = self->data.note.note;
+        *value = self->data.note.velocity;
+        break;
+    case SEQ_EVENT_DATA_FLAG_CONTROL:
+        *channel = self->data.control.channel;
+        *param = self->data.control.param;
+        *value = self->data.control.value;
+        break;
+    default:
+        *channel = 0;
+        *param = 0;
+        *value = 0;
+        break;
+    }
+}
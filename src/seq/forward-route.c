@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+/**
+ * ALSASeqForwardRoute:
+ * A boxed object to express route to forward events in user space.
+ *
+ * A [struct@ForwardRoute] is a boxed object to express route to forward events received by
+ * [class@UserClient]. The route matches events by the address of source, the type of event, and
+ * the channel, then the matched events are delivered to the address of destination with optional
+ * transforms; channel remap, transpose, and velocity curve. The route is added to the client by
+ * [method@UserClient.add_forward_route].
+ */
+ALSASeqForwardRoute *seq_forward_route_copy(const ALSASeqForwardRoute *self)
+{
+#ifdef g_memdup2
+    return g_memdup2(self, sizeof(*self));
+#else
+    // GLib v2.68 deprecated g_memdup() with concern about overflow by narrow conversion from size_t to
+    // unsigned int however it's safe in the local case.
+    gpointer ptr = g_malloc(sizeof(*self));
+    memcpy(ptr, self, sizeof(*self));
+    return ptr;
+#endif
+}
+
+G_DEFINE_BOXED_TYPE(ALSASeqForwardRoute, alsaseq_forward_route, seq_forward_route_copy, g_free)
+
+/**
+ * alsaseq_forward_route_new:
+ * @source: The address of source for events to match.
+ * @destination: The address of destination for matched events.
+ *
+ * Allocate and return an instance of [struct@ForwardRoute]. The route matches any type of event
+ * and any channel, and includes no transform.
+ *
+ * Returns: A [struct@ForwardRoute].
+ */
+ALSASeqForwardRoute *alsaseq_forward_route_new(const ALSASeqAddr *source,
+                                               const ALSASeqAddr *destination)
+{
+    ALSASeqForwardRoute *self;
+
+    g_return_val_if_fail(source != NULL, NULL);
+    g_return_val_if_fail(destination != NULL, NULL);
+
+    self = g_malloc0(sizeof(*self));
+
+    self->source = *source;
+    self->destination = *destination;
+    self->any_event_type = TRUE;
+    self->channel = -1;
+    self->channel_remap = -1;
+
+    return self;
+}
+
+/**
+ * alsaseq_forward_route_set_event_types:
+ * @self: A [struct@ForwardRoute].
+ * @event_types: (array length=count): The array with elements of [enum@EventType].
+ * @count: The number of elements in the array. Zero means any type of event.
+ *
+ * Set the types of event to match.
+ */
+void alsaseq_forward_route_set_event_types(ALSASeqForwardRoute *self,
+                                           const ALSASeqEventType *event_types, gsize count)
+{
+    gsize i;
+
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(event_types != NULL || count == 0);
+
+    memset(self->event_types, 0, sizeof(self->event_types));
+    for (i = 0; i < count; ++i) {
+        guint type = event_types[i];
+
+        g_return_if_fail(type <= G_MAXUINT8);
+        self->event_types[type / 32] |= 1u << (type % 32);
+    }
+    self->any_event_type = (count == 0);
+}
+
+/**
+ * alsaseq_forward_route_set_channel:
+ * @self: A [struct@ForwardRoute].
+ * @channel: The channel to match, between 0 and 15. Negative value means any channel.
+ *
+ * Set the channel to match. The channel is checked for the events with note and control data
+ * except for the events without channel; [enum@EventType].SONGPOS, [enum@EventType].SONGSEL,
+ * [enum@EventType].QFRAME, [enum@EventType].TIMESIGN, and [enum@EventType].KEYSIGN.
+ */
+void alsaseq_forward_route_set_channel(ALSASeqForwardRoute *self, gint channel)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(channel < 16);
+
+    self->channel = channel < 0 ? -1 : channel;
+}
+
+/**
+ * alsaseq_forward_route_set_channel_remap:
+ * @self: A [struct@ForwardRoute].
+ * @channel: The channel to which the matched events are remapped, between 0 and 15. Negative
+ *           value means no remap.
+ *
+ * Set the channel to which the matched events with channel are remapped.
+ */
+void alsaseq_forward_route_set_channel_remap(ALSASeqForwardRoute *self, gint channel)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(channel < 16);
+
+    self->channel_remap = channel < 0 ? -1 : channel;
+}
+
+/**
+ * alsaseq_forward_route_set_transpose:
+ * @self: A [struct@ForwardRoute].
+ * @semitones: The number of semitones to transpose, between -127 and 127.
+ *
+ * Set the number of semitones to transpose the note of matched events with note data. The result
+ * is clamped between 0 and 127.
+ */
+void alsaseq_forward_route_set_transpose(ALSASeqForwardRoute *self, gint semitones)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(semitones >= -127 && semitones <= 127);
+
+    self->transpose = semitones;
+}
+
+/**
+ * alsaseq_forward_route_set_velocity_curve:
+ * @self: A [struct@ForwardRoute].
+ * @curve: (array length=length)(nullable): The table to map velocity, or %NULL to disable it.
+ * @length: The number of elements in the table, 128 or zero.
+ *
+ * Set the table to map the velocity of matched events with note data. The velocity of
+ * [enum@EventType].NOTEON with zero is not mapped, since it has the same meaning as
+ * [enum@EventType].NOTEOFF.
+ */
+void alsaseq_forward_route_set_velocity_curve(ALSASeqForwardRoute *self, const guint8 *curve,
+                                              gsize length)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail((curve == NULL && length == 0) ||
+                     (curve != NULL && length == G_N_ELEMENTS(self->velocity_curve)));
+
+    if (curve != NULL)
+        memcpy(self->velocity_curve, curve, sizeof(self->velocity_curve));
+    self->has_velocity_curve = (curve != NULL);
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_FORWARD_ROUTE_H__
+#define __ALSA_GOBJECT_ALSASEQ_FORWARD_ROUTE_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_FORWARD_ROUTE  (alsaseq_forward_route_get_type())
+
+typedef struct {
+    /*< private >*/
+    struct snd_seq_addr source;
+    struct snd_seq_addr destination;
+    guint32 event_types[8];
+    gboolean any_event_type;
+    gint channel;
+    gint channel_remap;
+    gint transpose;
+    gboolean has_velocity_curve;
+    guint8 velocity_curve[128];
+} ALSASeqForwardRoute;
+
+GType alsaseq_forward_route_get_type() G_GNUC_CONST;
+
+ALSASeqForwardRoute *alsaseq_forward_route_new(const ALSASeqAddr *source,
+                                               const ALSASeqAddr *destination);
+
+void alsaseq_forward_route_set_event_types(ALSASeqForwardRoute *self,
+                                           const ALSASeqEventType *event_types, gsize count);
+
+void alsaseq_forward_route_set_channel(ALSASeqForwardRoute *self, gint channel);
+
+void alsaseq_forward_route_set_channel_remap(ALSASeqForwardRoute *self, gint channel);
+
+void alsaseq_forward_route_set_transpose(ALSASeqForwardRoute *self, gint semitones);
+
+void alsaseq_forward_route_set_velocity_curve(ALSASeqForwardRoute *self, const guint8 *curve,
+                                              gsize length);
+
+G_END_DECLS
+
+#endif
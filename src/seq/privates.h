@@ -12,6 +12,9 @@ void seq_system_info_refer_private(ALSASeqSystemInfo *self,
 void seq_client_info_refer_private(ALSASeqClientInfo *self,
                                    struct snd_seq_client_info **info);
 
+void seq_client_info_fill_event_filter(struct snd_seq_client_info *info,
+                                       const ALSASeqEventType *event_types, gsize event_type_count);
+
 void seq_port_info_refer_private(ALSASeqPortInfo *self,
                                  struct snd_seq_port_info **info);
 
@@ -36,10 +39,46 @@ void seq_queue_timer_alsa_refer_private(ALSASeqQueueTimerAlsa *self,
 void seq_remove_filter_refer_private(ALSASeqRemoveFilter *self,
                                      struct snd_seq_remove_events **data);
 
-void seq_event_cntr_serialize(ALSASeqEventCntr *self, const GList *events, gboolean aligned);
+int seq_user_client_get_fd(ALSASeqUserClient *self);
+void seq_user_client_emit_event_cntr(ALSASeqUserClient *self, const ALSASeqEventCntr *ev_cntr);
+gboolean seq_user_client_control_queue(ALSASeqUserClient *self, guint8 queue_id,
+                                       guint8 event_type, GError **error);
+
+gboolean seq_query_system_info(int fd, ALSASeqSystemInfo **system_info, GError **error);
+gboolean seq_query_client_id_list(int fd, guint8 **entries, gsize *entry_count, GError **error);
+gboolean seq_query_client_info(int fd, guint8 client_id, ALSASeqClientInfo **client_info,
+                               GError **error);
+gboolean seq_query_port_id_list(int fd, guint8 client_id, guint8 **entries, gsize *entry_count,
+                                GError **error);
+gboolean seq_query_port_info(int fd, guint8 client_id, guint8 port_id,
+                             ALSASeqPortInfo **port_info, GError **error);
+gboolean seq_query_client_pool(int fd, guint8 client_id, ALSASeqClientPool **client_pool,
+                               GError **error);
+gboolean seq_query_subscription_list(int fd, const ALSASeqAddr *addr,
+                                     ALSASeqQuerySubscribeType query_type, GList **entries,
+                                     GError **error);
+gboolean seq_query_queue_id_list(int fd, guint8 **entries, gsize *entry_count, GError **error);
+gboolean seq_query_queue_info_by_id(int fd, guint8 queue_id, ALSASeqQueueInfo **queue_info,
+                                    GError **error);
+gboolean seq_query_queue_info_by_name(int fd, const gchar *name, ALSASeqQueueInfo **queue_info,
+                                      GError **error);
+gboolean seq_query_queue_status(int fd, guint8 queue_id, ALSASeqQueueStatus *queue_status,
+                                GError **error);
+
+// Return TRUE when the event is written as the event of VARUSR pointing to the blob.
+typedef gboolean (*SeqEventPointerDataFunc)(const ALSASeqEvent *event, gpointer user_data);
+
+void seq_event_cntr_serialize(ALSASeqEventCntr *self, const GList *events, gboolean aligned,
+                              SeqEventPointerDataFunc to_pointer, gpointer user_data);
 void seq_event_copy_flattened(const ALSASeqEvent *self, guint8 *buf, gsize length);
 gsize seq_event_calculate_flattened_length(const ALSASeqEvent *self, gboolean aligned);
 gboolean seq_event_is_deliverable(const ALSASeqEvent *self);
+gboolean seq_event_is_pointer_data_candidate(const ALSASeqEvent *self, gsize threshold);
+void seq_event_extract_channel_data(const ALSASeqEvent *self, guint8 *channel, guint32 *param,
+                                    gint32 *value);
+
+// The default tempo in Standard MIDI File; 120 beats per minute.
+#define SMF_DEFAULT_TEMPO           500000
 
 #define QUEUE_ID_PROP_NAME          "queue-id"
 #define TIMER_TYPE_PROP_NAME        "timer-type"
@@ -0,0 +1,448 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+#include <utils.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+/**
+ * ALSASeqQuerySession:
+ * A GObject-derived object to query information of ALSA sequencer with single file descriptor.
+ *
+ * A [class@QuerySession] is a GObject-derived object to query information of ALSA sequencer. The
+ * functions such as [func@get_client_info] open and close ALSA sequencer character device in
+ * each call, thus kernel client is registered and unregistered each time. When the call of
+ * [method@QuerySession.open], the object maintains file descriptor till object destruction, and
+ * the queries are done with the file descriptor.
+ */
+typedef struct {
+    int fd;
+} ALSASeqQuerySessionPrivate;
+G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqQuerySession, alsaseq_query_session, G_TYPE_OBJECT)
+
+static void seq_query_session_finalize(GObject *obj)
+{
+    ALSASeqQuerySession *self = ALSASEQ_QUERY_SESSION(obj);
+    ALSASeqQuerySessionPrivate *priv = alsaseq_query_session_get_instance_private(self);
+
+    if (priv->fd >= 0)
+        close(priv->fd);
+
+    G_OBJECT_CLASS(alsaseq_query_session_parent_class)->finalize(obj);
+}
+
+static void alsaseq_query_session_class_init(ALSASeqQuerySessionClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = seq_query_session_finalize;
+}
+
+static void alsaseq_query_session_init(ALSASeqQuerySession *self)
+{
+    ALSASeqQuerySessionPrivate *priv = alsaseq_query_session_get_instance_private(self);
+
+    priv->fd = -1;
+}
+
+/**
+ * alsaseq_query_session_new:
+ *
+ * Allocate and return an instance of [class@QuerySession].
+ *
+ * Returns: An instance of [class@QuerySession].
+ */
+ALSASeqQuerySession *alsaseq_query_session_new()
+{
+    return g_object_new(ALSASEQ_TYPE_QUERY_SESSION, NULL);
+}
+
+/**
+ * alsaseq_query_session_open:
+ * @self: A [class@QuerySession].
+ * @open_flag: The flag of `open(2)` system call. `O_RDONLY` is forced to fulfil internally.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Open ALSA sequencer character device to query.
+ *
+ * The call of function executes `open(2)` system call for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_open(ALSASeqQuerySession *self, gint open_flag, GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+    char *devnode;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+
+    g_return_val_if_fail(priv->fd < 0, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (!alsaseq_get_seq_devnode(&devnode, error))
+        return FALSE;
+
+    open_flag &= ~O_ACCMODE;
+    open_flag |= O_RDONLY;
+    priv->fd = open(devnode, open_flag);
+    if (priv->fd < 0)
+        generate_file_error(error, errno, "open(%s)", devnode);
+    g_free(devnode);
+
+    return priv->fd >= 0;
+}
+
+/**
+ * alsaseq_query_session_get_system_info:
+ * @self: A [class@QuerySession].
+ * @system_info: (out): The information of ALSA Sequencer.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get information of ALSA Sequencer, as well as [func@get_system_info].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_SYSTEM_INFO` command
+ * for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_system_info(ALSASeqQuerySession *self,
+                                               ALSASeqSystemInfo **system_info, GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(system_info != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_system_info(priv->fd, system_info, error);
+}
+
+/**
+ * alsaseq_query_session_get_client_id_list:
+ * @self: A [class@QuerySession].
+ * @entries: (array length=entry_count)(out): The array with elements for numeric identified of
+ *           client. One of [enum@SpecificClientId] can be included in result as well as any
+ *           numeric value.
+ * @entry_count: The number of entries.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the list of clients as the numeric identifier, as well as [func@get_client_id_list].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_CLIENT_ID`,
+ * `SNDRV_SEQ_IOCTL_SYSTEM_INFO`, and `SNDRV_SEQ_IOCTL_QUERY_NEXT_CLIENT` command for ALSA
+ * sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_client_id_list(ALSASeqQuerySession *self, guint8 **entries,
+                                                  gsize *entry_count, GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(entries != NULL, FALSE);
+    g_return_val_if_fail(entry_count != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_client_id_list(priv->fd, entries, entry_count, error);
+}
+
+/**
+ * alsaseq_query_session_get_client_info:
+ * @self: A [class@QuerySession].
+ * @client_id: The numeric identifier of client to query. One of [enum@SpecificClientId] is
+ *             available as well as any numeric value.
+ * @client_info: (out): A [class@ClientInfo] for the client.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the information of client according to the numeric ID, as well as
+ * [func@get_client_info].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_CLIENT_INFO`
+ * command for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_client_info(ALSASeqQuerySession *self, guint8 client_id,
+                                               ALSASeqClientInfo **client_info, GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(client_info != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_client_info(priv->fd, client_id, client_info, error);
+}
+
+/**
+ * alsaseq_query_session_get_port_id_list:
+ * @self: A [class@QuerySession].
+ * @client_id: The numeric ID of client to query. One of [enum@SpecificClientId] is available as
+ *             well as any numeric value.
+ * @entries: (array length=entry_count)(out): The array with elements for numeric identifier of
+ *           port. One of [enum@SpecificPortId] is available as well as any numeric value.
+ * @entry_count: The number of entries in the array.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the list of numeric identifiers for port added by the client, as well as
+ * [func@get_port_id_list].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_CLIENT_INFO` and
+ * `SNDRV_SEQ_IOCTL_QUERY_NEXT_PORT` commands for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_port_id_list(ALSASeqQuerySession *self, guint8 client_id,
+                                                guint8 **entries, gsize *entry_count,
+                                                GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(entries != NULL, FALSE);
+    g_return_val_if_fail(entry_count != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_port_id_list(priv->fd, client_id, entries, entry_count, error);
+}
+
+/**
+ * alsaseq_query_session_get_port_info:
+ * @self: A [class@QuerySession].
+ * @client_id: The numeric identifier of client to query. One of [enum@SpecificClientId] is
+ *             available as well as any numerica value.
+ * @port_id: The numeric identifier of port in the client. One of [enum@SpecificPortId] is
+ *           available as well as any numeric value.
+ * @port_info: (out): A [class@PortInfo] for the port.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the information of port in client, as well as [func@get_port_info].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_PORT_INFO`
+ * command for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_port_info(ALSASeqQuerySession *self, guint8 client_id,
+                                             guint8 port_id, ALSASeqPortInfo **port_info,
+                                             GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(port_info != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_port_info(priv->fd, client_id, port_id, port_info, error);
+}
+
+/**
+ * alsaseq_query_session_get_client_pool:
+ * @self: A [class@QuerySession].
+ * @client_id: The numeric ID of client to query. One of [enum@SpecificClientId] is available as
+ *             well as any numeric value.
+ * @client_pool: (out): The information of memory pool for the client.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get statistical information of memory pool for the given client, as well as
+ * [func@get_client_pool].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_CLIENT_POOL`
+ * command for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_client_pool(ALSASeqQuerySession *self, guint8 client_id,
+                                               ALSASeqClientPool **client_pool, GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(client_pool != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_client_pool(priv->fd, client_id, client_pool, error);
+}
+
+/**
+ * alsaseq_query_session_get_subscription_list:
+ * @self: A [class@QuerySession].
+ * @addr: A [struct@Addr] to query.
+ * @query_type: The type of query, one of [enum@QuerySubscribeType].
+ * @entries: (element-type ALSASeq.SubscribeData)(out): The array with element for subscription
+ *           data.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the list of subscription for given address and query type, as well as
+ * [func@get_subscription_list].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_QUERY_SUBS` command
+ * for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_subscription_list(ALSASeqQuerySession *self,
+                                                     const ALSASeqAddr *addr,
+                                                     ALSASeqQuerySubscribeType query_type,
+                                                     GList **entries, GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(entries != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_subscription_list(priv->fd, addr, query_type, entries, error);
+}
+
+/**
+ * alsaseq_query_session_get_queue_id_list:
+ * @self: A [class@QuerySession].
+ * @entries: (array length=entry_count)(out): The array of elements for numeric identifier of queue.
+ * @entry_count: The number of entries.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the list of queue in ALSA Sequencer, as well as [func@get_queue_id_list].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_SYSTEM_INFO` and
+ * `SNDRV_SEQ_IOCTL_GET_QUEUE_INFO` commands for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_queue_id_list(ALSASeqQuerySession *self, guint8 **entries,
+                                                 gsize *entry_count, GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(entries != NULL, FALSE);
+    g_return_val_if_fail(entry_count != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_queue_id_list(priv->fd, entries, entry_count, error);
+}
+
+/**
+ * alsaseq_query_session_get_queue_info_by_id:
+ * @self: A [class@QuerySession].
+ * @queue_id: The numeric ID of queue. One of [enum@SpecificQueueId] is available as well.
+ * @queue_info: (out): The information of queue.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the information of queue, according to the numeric ID, as well as
+ * [func@get_queue_info_by_id].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_QUEUE_INFO`
+ * command for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_queue_info_by_id(ALSASeqQuerySession *self, guint8 queue_id,
+                                                    ALSASeqQueueInfo **queue_info,
+                                                    GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(queue_info != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_queue_info_by_id(priv->fd, queue_id, queue_info, error);
+}
+
+/**
+ * alsaseq_query_session_get_queue_info_by_name:
+ * @self: A [class@QuerySession].
+ * @name: The name string of queue to query.
+ * @queue_info: (out): The information of queue.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get the information of queue, according to the name string, as well as
+ * [func@get_queue_info_by_name].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_NAMED_QUEUE`
+ * command for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_queue_info_by_name(ALSASeqQuerySession *self,
+                                                      const gchar *name,
+                                                      ALSASeqQueueInfo **queue_info,
+                                                      GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(name != NULL, FALSE);
+    g_return_val_if_fail(queue_info != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_queue_info_by_name(priv->fd, name, queue_info, error);
+}
+
+/**
+ * alsaseq_query_session_get_queue_status:
+ * @self: A [class@QuerySession].
+ * @queue_id: The numeric ID of queue. One of [enum@SpecificQueueId] is available as well.
+ * @queue_status: (inout): The current status of queue.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `GLib.FileError`.
+ *
+ * Get current status of queue, as well as [func@get_queue_status].
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_QUEUE_STATUS`
+ * command for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_query_session_get_queue_status(ALSASeqQuerySession *self, guint8 queue_id,
+                                                ALSASeqQueueStatus *const *queue_status,
+                                                GError **error)
+{
+    ALSASeqQuerySessionPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_QUERY_SESSION(self), FALSE);
+    priv = alsaseq_query_session_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(queue_status != NULL, FALSE);
+    g_return_val_if_fail(ALSASEQ_IS_QUEUE_STATUS(*queue_status), FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    return seq_query_queue_status(priv->fd, queue_id, *queue_status, error);
+}
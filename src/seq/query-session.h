@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_QUERY_SESSION_H__
+#define __ALSA_GOBJECT_ALSASEQ_QUERY_SESSION_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_QUERY_SESSION   (alsaseq_query_session_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(ALSASeqQuerySession, alsaseq_query_session, ALSASEQ, QUERY_SESSION,
+                         GObject);
+
+struct _ALSASeqQuerySessionClass {
+    GObjectClass parent_class;
+};
+
+ALSASeqQuerySession *alsaseq_query_session_new();
+
+gboolean alsaseq_query_session_open(ALSASeqQuerySession *self, gint open_flag, GError **error);
+
+gboolean alsaseq_query_session_get_system_info(ALSASeqQuerySession *self,
+                                               ALSASeqSystemInfo **system_info, GError **error);
+
+gboolean alsaseq_query_session_get_client_id_list(ALSASeqQuerySession *self, guint8 **entries,
+                                                  gsize *entry_count, GError **error);
+
+gboolean alsaseq_query_session_get_client_info(ALSASeqQuerySession *self, guint8 client_id,
+                                               ALSASeqClientInfo **client_info, GError **error);
+
+gboolean alsaseq_query_session_get_port_id_list(ALSASeqQuerySession *self, guint8 client_id,
+                                                guint8 **entries, gsize *entry_count,
+                                                GError **error);
+
+gboolean alsaseq_query_session_get_port_info(ALSASeqQuerySession *self, guint8 client_id,
+                                             guint8 port_id, ALSASeqPortInfo **port_info,
+                                             GError **error);
+
+gboolean alsaseq_query_session_get_client_pool(ALSASeqQuerySession *self, guint8 client_id,
+                                               ALSASeqClientPool **client_pool, GError **error);
+
+gboolean alsaseq_query_session_get_subscription_list(ALSASeqQuerySession *self,
+                                                     const ALSASeqAddr *addr,
+                                                     ALSASeqQuerySubscribeType query_type,
+                                                     GList **entries, GError **error);
+
+gboolean alsaseq_query_session_get_queue_id_list(ALSASeqQuerySession *self, guint8 **entries,
+                                                 gsize *entry_count, GError **error);
+
+gboolean alsaseq_query_session_get_queue_info_by_id(ALSASeqQuerySession *self, guint8 queue_id,
+                                                    ALSASeqQueueInfo **queue_info,
+                                                    GError **error);
+gboolean alsaseq_query_session_get_queue_info_by_name(ALSASeqQuerySession *self,
+                                                      const gchar *name,
+                                                      ALSASeqQueueInfo **queue_info,
+                                                      GError **error);
+
+gboolean alsaseq_query_session_get_queue_status(ALSASeqQuerySession *self, guint8 queue_id,
+                                                ALSASeqQueueStatus *const *queue_status,
+                                                GError **error);
+
+G_END_DECLS
+
+#endif
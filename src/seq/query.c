@@ -83,6 +83,354 @@ static gboolean open_fd(int *fd, GError **error)
     return result;
 }
 
+gboolean seq_query_system_info(int fd, ALSASeqSystemInfo **system_info, GError **error)
+{
+    struct snd_seq_system_info *info;
+
+    *system_info = g_object_new(ALSASEQ_TYPE_SYSTEM_INFO, NULL);
+    seq_system_info_refer_private(*system_info, &info);
+
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_SYSTEM_INFO, info) < 0) {
+        generate_file_error(error, errno, "ioctl(SYSTEM_INFO)");
+        g_object_unref(*system_info);
+        *system_info = NULL;
+        return FALSE;
+    }
+
+    // Decrement count for the connection of the file descriptor.
+    --info->cur_clients;
+
+    return TRUE;
+}
+
+gboolean seq_query_client_id_list(int fd, guint8 **entries, gsize *entry_count, GError **error)
+{
+    int my_id;
+    struct snd_seq_system_info system_info = {0};
+    unsigned int count;
+    guint8 *list;
+    unsigned int index;
+    struct snd_seq_client_info client_info = {0};
+    gboolean result;
+
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_CLIENT_ID, &my_id) < 0) {
+        generate_file_error(error, errno, "ioctl(CLIENT_ID)");
+        return FALSE;
+    }
+
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_SYSTEM_INFO, &system_info) < 0) {
+        generate_file_error(error, errno, "ioctl(SYSTEM_INFO)");
+        return FALSE;
+    }
+
+    // Exclude myself.
+    count = system_info.cur_clients - 1;
+    if (count == 0)  {
+        *entry_count = 0;
+        return TRUE;
+    }
+
+    list = g_malloc0_n(count, sizeof(guint));
+
+    index = 0;
+
+    result = TRUE;
+    client_info.client = -1;
+    while (index < count) {
+        if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_NEXT_CLIENT, &client_info) < 0) {
+            if (errno != ENOENT) {
+                generate_file_error(error, errno, "ioctl(QUERY_NEXT_CLIENT)");
+                result = FALSE;
+            }
+            break;
+        }
+
+        if (client_info.client != my_id) {
+            list[index] = client_info.client;
+            ++index;
+        }
+    }
+
+    if (!result) {
+        g_free(list);
+        return FALSE;
+    }
+
+    g_warn_if_fail(index == count);
+
+    *entries = list;
+    *entry_count = count;
+
+    return TRUE;
+}
+
+gboolean seq_query_client_info(int fd, guint8 client_id, ALSASeqClientInfo **client_info,
+                               GError **error)
+{
+    struct snd_seq_client_info *info;
+
+    *client_info = g_object_new(ALSASEQ_TYPE_CLIENT_INFO, NULL);
+    seq_client_info_refer_private(*client_info, &info);
+
+    info->client = client_id;
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, info) < 0) {
+        generate_file_error(error, errno, "ioctl(GET_CLIENT_INFO)");
+        g_object_unref(*client_info);
+        *client_info = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+gboolean seq_query_port_id_list(int fd, guint8 client_id, guint8 **entries, gsize *entry_count,
+                                GError **error)
+{
+    struct snd_seq_client_info client_info = {0};
+    unsigned int count;
+    guint8 *list;
+    unsigned int index;
+    struct snd_seq_port_info port_info = {0};
+    gboolean result;
+
+    client_info.client = client_id;
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, &client_info) < 0) {
+        generate_file_error(error, errno, "ioctl(GET_CLIENT_INFO)");
+        return FALSE;
+    }
+
+    count = client_info.num_ports;
+    list = g_malloc0_n(count, sizeof(*list));
+
+    index = 0;
+
+    result = TRUE;
+    port_info.addr.client = client_id;
+    port_info.addr.port = -1;
+    while (index < count) {
+        if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_NEXT_PORT, &port_info) < 0) {
+            if (errno != ENOENT) {
+                generate_file_error(error, errno, "ioctl(QUERY_NEXT_PORT)");
+                result = FALSE;
+            }
+            break;
+        }
+
+        list[index] = port_info.addr.port;
+        ++index;
+    }
+
+    if (!result) {
+        g_free(list);
+        return FALSE;
+    }
+
+    g_warn_if_fail(index == count);
+
+    *entries = list;
+    *entry_count = count;
+
+    return TRUE;
+}
+
+gboolean seq_query_port_info(int fd, guint8 client_id, guint8 port_id,
+                             ALSASeqPortInfo **port_info, GError **error)
+{
+    struct snd_seq_port_info *info;
+
+    *port_info = g_object_new(ALSASEQ_TYPE_PORT_INFO, NULL);
+    seq_port_info_refer_private(*port_info, &info);
+
+    info->addr.client = client_id;
+    info->addr.port = port_id;
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_PORT_INFO, info) < 0) {
+        generate_file_error(error, errno, "ioctl(GET_PORT_INFO)");
+        g_object_unref(*port_info);
+        *port_info = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+gboolean seq_query_client_pool(int fd, guint8 client_id, ALSASeqClientPool **client_pool,
+                               GError **error)
+{
+    struct snd_seq_client_pool *pool;
+
+    *client_pool = g_object_new(ALSASEQ_TYPE_CLIENT_POOL, NULL);
+    seq_client_pool_refer_private(*client_pool, &pool);
+
+    pool->client = client_id;
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_CLIENT_POOL, pool) < 0) {
+        generate_file_error(error, errno, "ioctl(GET_CLIENT_POOL)");
+        g_object_unref(*client_pool);
+        *client_pool = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void fill_data_with_result(struct snd_seq_port_subscribe *data,
+                                  struct snd_seq_query_subs *query)
+{
+    if (query->type == SNDRV_SEQ_QUERY_SUBS_READ) {
+        data->sender = query->root;
+        data->dest = query->addr;
+    } else {
+        data->sender = query->addr;
+        data->dest = query->root;
+    }
+    data->queue = query->queue;
+    data->flags = query->flags;
+}
+
+// ALSA Sequencer core reports ENOENT for the index beyond the last subscription. It is regarded as
+// the end of list, since the subscription can be removed between the calls.
+gboolean seq_query_subscription_list(int fd, const ALSASeqAddr *addr,
+                                     ALSASeqQuerySubscribeType query_type, GList **entries,
+                                     GError **error)
+{
+    struct snd_seq_query_subs query = {0};
+    unsigned int count;
+    unsigned int index;
+
+    query.root = *addr;
+    query.type = query_type;
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_SUBS, &query) < 0) {
+        if (errno == ENOENT)
+            return TRUE;
+        generate_file_error(error, errno, "ioctl(QUERY_SUBS)");
+        return FALSE;
+    }
+    count = query.num_subs;
+
+    index = 0;
+    while (index < count) {
+        ALSASeqSubscribeData *subs_data = g_object_new(ALSASEQ_TYPE_SUBSCRIBE_DATA, NULL);
+        struct snd_seq_port_subscribe *data;
+
+        seq_subscribe_data_refer_private(subs_data, &data);
+        fill_data_with_result(data, &query);
+
+        *entries = g_list_append(*entries, (gpointer)subs_data);
+        ++index;
+        if (index >= count)
+            break;
+
+        ++query.index;
+        if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_SUBS, &query) < 0) {
+            if (errno == ENOENT)
+                break;
+            generate_file_error(error, errno, "ioctl(QUERY_SUBS)");
+            g_list_free_full(*entries, g_object_unref);
+            *entries = NULL;
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+gboolean seq_query_queue_id_list(int fd, guint8 **entries, gsize *entry_count, GError **error)
+{
+    struct snd_seq_system_info info = {0};
+    unsigned int maximum_count;
+    unsigned int count;
+    guint8 *list;
+    unsigned int index;
+    int i;
+
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_SYSTEM_INFO, &info) < 0) {
+        generate_file_error(error, errno, "ioctl(SYSTEM_INFO)");
+        return FALSE;
+    }
+    maximum_count = info.queues;
+    count = info.cur_queues;
+
+    if (count == 0) {
+        *entry_count = 0;
+        return TRUE;
+    }
+
+    list = g_malloc0_n(count, sizeof(*list));
+
+    index = 0;
+    for (i = 0; i < maximum_count; ++i) {
+        struct snd_seq_queue_info info;
+
+        info.queue = i;
+        if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_QUEUE_INFO, &info) < 0)
+            continue;
+
+        list[index] = i;
+        if (++index >= count)
+            break;
+    }
+
+    g_warn_if_fail(index == count);
+
+    *entries = list;
+    *entry_count = count;
+
+    return TRUE;
+}
+
+gboolean seq_query_queue_info_by_id(int fd, guint8 queue_id, ALSASeqQueueInfo **queue_info,
+                                    GError **error)
+{
+    struct snd_seq_queue_info *info;
+
+    *queue_info = g_object_new(ALSASEQ_TYPE_QUEUE_INFO, NULL);
+    seq_queue_info_refer_private(*queue_info, &info);
+
+    info->queue = queue_id;
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_QUEUE_INFO, info) < 0) {
+        generate_file_error(error, errno, "ioctl(GET_QUEUE_INFO)");
+        g_object_unref(*queue_info);
+        *queue_info = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+gboolean seq_query_queue_info_by_name(int fd, const gchar *name, ALSASeqQueueInfo **queue_info,
+                                      GError **error)
+{
+    struct snd_seq_queue_info *info;
+
+    *queue_info = g_object_new(ALSASEQ_TYPE_QUEUE_INFO, NULL);
+    seq_queue_info_refer_private(*queue_info, &info);
+
+    g_strlcpy(info->name, name, sizeof(info->name));
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_NAMED_QUEUE, info) < 0) {
+        generate_file_error(error, errno, "ioctl(GET_NAMED_QUEUE)");
+        g_object_unref(*queue_info);
+        *queue_info = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+gboolean seq_query_queue_status(int fd, guint8 queue_id, ALSASeqQueueStatus *queue_status,
+                                GError **error)
+{
+    struct snd_seq_queue_status *status;
+
+    seq_queue_status_refer_private(queue_status, &status);
+
+    status->queue = (int)queue_id;
+    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_QUEUE_STATUS, status) < 0) {
+        generate_file_error(error, errno, "ioctl(GET_QUEUE_STATUS)");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 /**
  * alsaseq_get_system_info:
  * @system_info: (out): The information of ALSA Sequencer.
@@ -97,7 +445,6 @@ static gboolean open_fd(int *fd, GError **error)
  */
 gboolean alsaseq_get_system_info(ALSASeqSystemInfo **system_info, GError **error)
 {
-    struct snd_seq_system_info *info;
     int fd;
     gboolean result;
 
@@ -107,23 +454,10 @@ gboolean alsaseq_get_system_info(ALSASeqSystemInfo **system_info, GError **error
     if (!open_fd(&fd, error))
         return FALSE;
 
-    *system_info = g_object_new(ALSASEQ_TYPE_SYSTEM_INFO, NULL);
-    seq_system_info_refer_private(*system_info, &info);
-
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_SYSTEM_INFO, info) < 0) {
-        generate_file_error(error, errno, "ioctl(SYSTEM_INFO)");
-        g_object_unref(*system_info);
-        *system_info = NULL;
-        result = FALSE;
-        goto end;
-    }
-
-    // Decrement count for the above connection.
-    --info->cur_clients;
+    result = seq_query_system_info(fd, system_info, error);
 
-    result = TRUE;
-end:
     close(fd);
+
     return result;
 }
 
@@ -145,12 +479,6 @@ end:
  */
 gboolean alsaseq_get_client_id_list(guint8 **entries, gsize *entry_count, GError **error)
 {
-    int my_id;
-    struct snd_seq_system_info system_info = {0};
-    unsigned int count;
-    guint8 *list;
-    unsigned int index;
-    struct snd_seq_client_info client_info = {0};
     int fd;
     gboolean result;
 
@@ -161,58 +489,10 @@ gboolean alsaseq_get_client_id_list(guint8 **entries, gsize *entry_count, GError
     if (!open_fd(&fd, error))
         return FALSE;
 
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_CLIENT_ID, &my_id) < 0) {
-        generate_file_error(error, errno, "ioctl(CLIENT_ID)");
-        result = FALSE;
-        goto end;
-    }
-
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_SYSTEM_INFO, &system_info) < 0) {
-        generate_file_error(error, errno, "ioctl(SYSTEM_INFO)");
-        result = FALSE;
-        goto end;
-    }
-
-    // Exclude myself.
-    count = system_info.cur_clients - 1;
-    if (count == 0)  {
-        *entry_count = 0;
-        result = TRUE;
-        goto end;
-    }
-
-    list = g_malloc0_n(count, sizeof(guint));
-
-    index = 0;
-
-    result = TRUE;
-    client_info.client = -1;
-    while (index < count) {
-        if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_NEXT_CLIENT, &client_info) < 0) {
-            if (errno != ENOENT) {
-                generate_file_error(error, errno, "ioctl(QUERY_NEXT_CLIENT)");
-                result = FALSE;
-            }
-            break;
-        }
-
-        if (client_info.client != my_id) {
-            list[index] = client_info.client;
-            ++index;
-        }
-    }
-
-    if (!result) {
-        g_free(list);
-        goto end;
-    }
-
-    g_warn_if_fail(index == count);
+    result = seq_query_client_id_list(fd, entries, entry_count, error);
 
-    *entries = list;
-    *entry_count = count;
-end:
     close(fd);
+
     return result;
 }
 
@@ -232,7 +512,6 @@ end:
  */
 gboolean alsaseq_get_client_info(guint8 client_id, ALSASeqClientInfo **client_info, GError **error)
 {
-    struct snd_seq_client_info *info;
     int fd;
     gboolean result;
 
@@ -242,18 +521,7 @@ gboolean alsaseq_get_client_info(guint8 client_id, ALSASeqClientInfo **client_in
     if (!open_fd(&fd, error))
         return FALSE;
 
-    *client_info = g_object_new(ALSASEQ_TYPE_CLIENT_INFO, NULL);
-    seq_client_info_refer_private(*client_info, &info);
-
-    info->client = client_id;
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, info) < 0) {
-        generate_file_error(error, errno, "ioctl(GET_CLIENT_INFO)");
-        g_object_unref(*client_info);
-        *client_info = NULL;
-        result = FALSE;
-    } else {
-        result = TRUE;
-    }
+    result = seq_query_client_info(fd, client_id, client_info, error);
 
     close(fd);
 
@@ -278,11 +546,6 @@ gboolean alsaseq_get_client_info(guint8 client_id, ALSASeqClientInfo **client_in
 gboolean alsaseq_get_port_id_list(guint8 client_id, guint8 **entries, gsize *entry_count,
                                   GError **error)
 {
-    struct snd_seq_client_info client_info = {0};
-    unsigned int count;
-    guint8 *list;
-    unsigned int index;
-    struct snd_seq_port_info port_info = {0};
     int fd;
     gboolean result;
 
@@ -293,46 +556,10 @@ gboolean alsaseq_get_port_id_list(guint8 client_id, guint8 **entries, gsize *ent
     if (!open_fd(&fd, error))
         return FALSE;
 
-    client_info.client = client_id;
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, &client_info) < 0) {
-        generate_file_error(error, errno, "ioctl(GET_CLIENT_INFO)");
-        result = FALSE;
-        goto end;
-    }
-
-    count = client_info.num_ports;
-    list = g_malloc0_n(count, sizeof(*list));
-
-    index = 0;
-
-    result = TRUE;
-    port_info.addr.client = client_id;
-    port_info.addr.port = -1;
-    while (index < count) {
-        if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_NEXT_PORT, &port_info) < 0) {
-            if (errno != ENOENT) {
-                generate_file_error(error, errno, "ioctl(QUERY_NEXT_PORT)");
-                result = FALSE;
-            }
-            break;
-        }
+    result = seq_query_port_id_list(fd, client_id, entries, entry_count, error);
 
-        list[index] = port_info.addr.port;
-        ++index;
-    }
     close(fd);
 
-    if (!result) {
-        g_free(list);
-        goto end;
-    }
-
-    g_warn_if_fail(index == count);
-
-    *entries = list;
-    *entry_count = count;
-end:
-    close(fd);
     return result;
 }
 
@@ -355,7 +582,6 @@ end:
 gboolean alsaseq_get_port_info(guint8 client_id, guint8 port_id, ALSASeqPortInfo **port_info,
                                GError **error)
 {
-    struct snd_seq_port_info *info;
     int fd;
     gboolean result;
 
@@ -365,19 +591,7 @@ gboolean alsaseq_get_port_info(guint8 client_id, guint8 port_id, ALSASeqPortInfo
     if (!open_fd(&fd, error))
         return FALSE;
 
-    *port_info = g_object_new(ALSASEQ_TYPE_PORT_INFO, NULL);
-    seq_port_info_refer_private(*port_info, &info);
-
-    info->addr.client = client_id;
-    info->addr.port = port_id;
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_PORT_INFO, info) < 0) {
-        generate_file_error(error, errno, "ioctl(GET_PORT_INFO)");
-        g_object_unref(*port_info);
-        *port_info = NULL;
-        result = FALSE;
-    } else {
-        result = TRUE;
-    }
+    result = seq_query_port_info(fd, client_id, port_id, port_info, error);
 
     close(fd);
 
@@ -401,7 +615,6 @@ gboolean alsaseq_get_port_info(guint8 client_id, guint8 port_id, ALSASeqPortInfo
 gboolean alsaseq_get_client_pool(guint8 client_id, ALSASeqClientPool **client_pool, GError **error)
 {
     int fd;
-    struct snd_seq_client_pool *pool;
     gboolean result;
 
     g_return_val_if_fail(client_pool != NULL, FALSE);
@@ -410,37 +623,13 @@ gboolean alsaseq_get_client_pool(guint8 client_id, ALSASeqClientPool **client_po
     if (!open_fd(&fd, error))
         return FALSE;
 
-    *client_pool = g_object_new(ALSASEQ_TYPE_CLIENT_POOL, NULL);
-    seq_client_pool_refer_private(*client_pool, &pool);
-
-    pool->client = client_id;
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_CLIENT_POOL, pool) < 0) {
-        generate_file_error(error, errno, "ioctl(GET_CLIENT_POOL)");
-        g_object_unref(*client_pool);
-        result = FALSE;
-    } else {
-        result = TRUE;
-    }
+    result = seq_query_client_pool(fd, client_id, client_pool, error);
 
     close(fd);
 
     return result;
 }
 
-static void fill_data_with_result(struct snd_seq_port_subscribe *data,
-                                  struct snd_seq_query_subs *query)
-{
-    if (query->type == SNDRV_SEQ_QUERY_SUBS_READ) {
-        data->sender = query->root;
-        data->dest = query->addr;
-    } else {
-        data->sender = query->addr;
-        data->dest = query->root;
-    }
-    data->queue = query->queue;
-    data->flags = query->flags;
-}
-
 /**
  * alsaseq_get_subscription_list:
  * @addr: A [struct@Addr] to query.
@@ -461,9 +650,6 @@ gboolean alsaseq_get_subscription_list(const ALSASeqAddr *addr,
                                        GError **error)
 {
     int fd;
-    struct snd_seq_query_subs query = {0};
-    unsigned int count;
-    unsigned int index;
     gboolean result;
 
     g_return_val_if_fail(entries != NULL, FALSE);
@@ -472,45 +658,10 @@ gboolean alsaseq_get_subscription_list(const ALSASeqAddr *addr,
     if (!open_fd(&fd, error))
         return FALSE;
 
-    g_object_get((gpointer)addr, "client-id", &query.root.client,
-                 "port-id", &query.root.port, NULL);
-    query.type = query_type;
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_SUBS, &query) < 0) {
-        if (errno != ENOENT)
-            generate_file_error(error, errno, "ioctl(QUERY_SUBS)");
-        result = FALSE;
-        goto end;
-    }
-    count = query.num_subs;
-
-    index = 0;
-    while (index < count) {
-        ALSASeqSubscribeData *subs_data = g_object_new(ALSASEQ_TYPE_SUBSCRIBE_DATA, NULL);
-        struct snd_seq_port_subscribe *data;
-
-        seq_subscribe_data_refer_private(subs_data, &data);
-        fill_data_with_result(data, &query);
-
-        *entries = g_list_append(*entries, (gpointer)subs_data);
-        ++index;
-
-        ++query.index;
-        if (ioctl(fd, SNDRV_SEQ_IOCTL_QUERY_SUBS, &query) < 0) {
-            if (errno != ENOENT)
-                generate_file_error(error, errno, "ioctl(QUERY_SUBS)");
-            result = FALSE;
-            break;
-        }
-    }
+    result = seq_query_subscription_list(fd, addr, query_type, entries, error);
 
-    if (!result) {
-        g_list_free_full(*entries, g_object_unref);
-        goto end;
-    }
-
-    g_warn_if_fail(index == count);
-end:
     close(fd);
+
     return result;
 }
 
@@ -531,13 +682,7 @@ end:
 gboolean alsaseq_get_queue_id_list(guint8 **entries, gsize *entry_count, GError **error)
 {
     int fd;
-    struct snd_seq_system_info info = {0};
-    unsigned int maximum_count;
-    unsigned int count;
-    guint8 *list;
-    unsigned int index;
     gboolean result;
-    int i;
 
     g_return_val_if_fail(entries != NULL, FALSE);
     g_return_val_if_fail(entry_count != NULL, FALSE);
@@ -546,41 +691,8 @@ gboolean alsaseq_get_queue_id_list(guint8 **entries, gsize *entry_count, GError
     if (!open_fd(&fd, error))
         return FALSE;
 
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_SYSTEM_INFO, &info) < 0) {
-        generate_file_error(error, errno, "ioctl(SYSTEM_INFO)");
-        result = FALSE;
-        goto end;
-    }
-    maximum_count = info.queues;
-    count = info.cur_queues;
-
-    if (count == 0) {
-        result = TRUE;
-        goto end;
-    }
-
-    list = g_malloc0_n(count, sizeof(*entries));
-
-    index = 0;
-    for (i = 0; i < maximum_count; ++i) {
-        struct snd_seq_queue_info info;
-
-        info.queue = i;
-        if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_QUEUE_INFO, &info) < 0)
-            continue;
-
-        list[index] = i;
-        if (++index >= count)
-            break;
-    }
-
-    g_warn_if_fail(index == count);
-
-    *entries = list;
-    *entry_count = count;
+    result = seq_query_queue_id_list(fd, entries, entry_count, error);
 
-    result = TRUE;
-end:
     close(fd);
 
     return result;
@@ -602,7 +714,6 @@ end:
 gboolean alsaseq_get_queue_info_by_id(guint8 queue_id, ALSASeqQueueInfo **queue_info,
                                       GError **error)
 {
-    struct snd_seq_queue_info *info;
     int fd;
     gboolean result;
 
@@ -612,17 +723,7 @@ gboolean alsaseq_get_queue_info_by_id(guint8 queue_id, ALSASeqQueueInfo **queue_
     if (!open_fd(&fd, error))
         return FALSE;
 
-    *queue_info = g_object_new(ALSASEQ_TYPE_QUEUE_INFO, NULL);
-    seq_queue_info_refer_private(*queue_info, &info);
-
-    info->queue = queue_id;
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_QUEUE_INFO, info) < 0) {
-        generate_file_error(error, errno, "ioctl(GET_QUEUE_INFO)");
-        g_object_unref(*queue_info);
-        result = FALSE;
-    } else {
-        result = TRUE;
-    }
+    result = seq_query_queue_info_by_id(fd, queue_id, queue_info, error);
 
     close(fd);
 
@@ -645,7 +746,6 @@ gboolean alsaseq_get_queue_info_by_id(guint8 queue_id, ALSASeqQueueInfo **queue_
 gboolean alsaseq_get_queue_info_by_name(const gchar *name, ALSASeqQueueInfo **queue_info,
                                         GError **error)
 {
-    struct snd_seq_queue_info *info;
     int fd;
     gboolean result;
 
@@ -655,17 +755,7 @@ gboolean alsaseq_get_queue_info_by_name(const gchar *name, ALSASeqQueueInfo **qu
     if (!open_fd(&fd, error))
         return FALSE;
 
-    *queue_info = g_object_new(ALSASEQ_TYPE_QUEUE_INFO, NULL);
-    seq_queue_info_refer_private(*queue_info, &info);
-
-    g_strlcpy(info->name, name, sizeof(info->name));
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_NAMED_QUEUE, info) < 0) {
-        generate_file_error(error, errno, "ioctl(GET_NAMED_QUEUE)");
-        g_object_unref(*queue_info);
-        result = FALSE;
-    } else {
-        result = TRUE;
-    }
+    result = seq_query_queue_info_by_name(fd, name, queue_info, error);
 
     close(fd);
 
@@ -688,26 +778,17 @@ gboolean alsaseq_get_queue_info_by_name(const gchar *name, ALSASeqQueueInfo **qu
 gboolean alsaseq_get_queue_status(guint8 queue_id, ALSASeqQueueStatus *const *queue_status,
                                   GError **error)
 {
-    struct snd_seq_queue_status *status;
     int fd;
     gboolean result;
 
     g_return_val_if_fail(queue_status != NULL, FALSE);
+    g_return_val_if_fail(ALSASEQ_IS_QUEUE_STATUS(*queue_status), FALSE);
     g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
     if (!open_fd(&fd, error))
         return FALSE;
 
-    g_return_val_if_fail(ALSASEQ_IS_QUEUE_STATUS(*queue_status), FALSE);
-    seq_queue_status_refer_private(*queue_status, &status);
-
-    status->queue = (int)queue_id;
-    if (ioctl(fd, SNDRV_SEQ_IOCTL_GET_QUEUE_STATUS, status) < 0) {
-        generate_file_error(error, errno, "ioctl(GET_QUEUE_STATUS)");
-        result = FALSE;
-    } else {
-        result = TRUE;
-    }
+    result = seq_query_queue_status(fd, queue_id, *queue_status, error);
 
     close(fd);
 
@@ -0,0 +1,903 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+#include <utils.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+/**
+ * ALSASeqSmfPlayer:
+ * A GObject-derived object to play Standard MIDI File onto queue.
+ *
+ * A [class@SmfPlayer] is a GObject-derived object to play Standard MIDI File (format 0 and 1) by
+ * [class@UserClient]. The file is mapped to memory by [method@SmfPlayer.load], then the events in
+ * tracks are merged lazily in the order of time when scheduled. The player keeps the events for
+ * the window of lookahead in the queue, and the window is refilled when the echo event scheduled
+ * by the player itself is delivered to the port of client. Therefore the source of client should
+ * be attached to [struct@GLib.MainContext] during playback.
+ */
+typedef struct {
+    const guint8 *pos;
+    const guint8 *end;
+    guint64 tick;
+    guint8 running_status;
+} SmfTrack;
+
+typedef struct {
+    guint8 *map;
+    gsize map_size;
+    guint16 format;
+    guint16 division;
+
+    SmfTrack *tracks;
+    const guint8 **track_heads;
+    const guint8 **track_tails;
+    guint track_count;
+    guint *heap;
+    guint heap_length;
+
+    ALSASeqUserClient *client;
+    guint8 client_id;
+    guint8 port_id;
+    guint8 queue_id;
+    gulong handler_id;
+    guint64 lookahead;
+
+    guint tempo;
+    guint64 last_tick;
+    guint64 last_time;
+
+    ALSASeqEventCntr *ev_cntr;
+    ALSASeqClientPool *pool;
+    GByteArray *blob;
+} ALSASeqSmfPlayerPrivate;
+G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqSmfPlayer, alsaseq_smf_player, G_TYPE_OBJECT)
+
+/**
+ * alsaseq_smf_player_error_quark:
+ *
+ * Return the [alias@GLib.Quark] for [struct@GLib.Error] which has code of
+ * `ALSASeq.SmfPlayerError`.
+ *
+ * Returns: A [alias@GLib.Quark].
+ */
+G_DEFINE_QUARK(alsaseq-smf-player-error-quark, alsaseq_smf_player_error)
+
+#define generate_local_error(exception, code, fmt) \
+        g_set_error_literal(exception, ALSASEQ_SMF_PLAYER_ERROR, code, fmt)
+
+// The marker in the echo event to refill the window of lookahead.
+#define SMF_ECHO_MAGIC          0x534d4650      // 'SMFP'
+
+enum seq_smf_player_prop_type {
+    SEQ_SMF_PLAYER_PROP_FORMAT = 1,
+    SEQ_SMF_PLAYER_PROP_DIVISION,
+    SEQ_SMF_PLAYER_PROP_TRACK_COUNT,
+    SEQ_SMF_PLAYER_PROP_QUEUE_ID,
+    SEQ_SMF_PLAYER_PROP_COUNT,
+};
+static GParamSpec *seq_smf_player_props[SEQ_SMF_PLAYER_PROP_COUNT] = { NULL, };
+
+enum seq_smf_player_sig_type {
+    SEQ_SMF_PLAYER_SIG_TYPE_FINISHED = 0,
+    SEQ_SMF_PLAYER_SIG_TYPE_PLAYBACK_FAILED,
+    SEQ_SMF_PLAYER_SIG_TYPE_COUNT,
+};
+static guint seq_smf_player_sigs[SEQ_SMF_PLAYER_SIG_TYPE_COUNT] = { 0 };
+
+static void seq_smf_player_unload(ALSASeqSmfPlayerPrivate *priv)
+{
+    if (priv->map != NULL)
+        munmap(priv->map, priv->map_size);
+    priv->map = NULL;
+    priv->map_size = 0;
+
+    g_free(priv->tracks);
+    g_free(priv->track_heads);
+    g_free(priv->track_tails);
+    g_free(priv->heap);
+    priv->tracks = NULL;
+    priv->track_heads = NULL;
+    priv->track_tails = NULL;
+    priv->heap = NULL;
+    priv->track_count = 0;
+    priv->heap_length = 0;
+}
+
+static void seq_smf_player_release_client(ALSASeqSmfPlayerPrivate *priv)
+{
+    if (priv->client == NULL)
+        return;
+
+    g_signal_handler_disconnect(priv->client, priv->handler_id);
+    g_object_unref(priv->client);
+    priv->client = NULL;
+    priv->handler_id = 0;
+}
+
+static void seq_smf_player_get_property(GObject *obj, guint id, GValue *val, GParamSpec *spec)
+{
+    ALSASeqSmfPlayer *self = ALSASEQ_SMF_PLAYER(obj);
+    ALSASeqSmfPlayerPrivate *priv = alsaseq_smf_player_get_instance_private(self);
+
+    switch (id) {
+    case SEQ_SMF_PLAYER_PROP_FORMAT:
+        g_value_set_uint(val, priv->format);
+        break;
+    case SEQ_SMF_PLAYER_PROP_DIVISION:
+        g_value_set_uint(val, priv->division);
+        break;
+    case SEQ_SMF_PLAYER_PROP_TRACK_COUNT:
+        g_value_set_uint(val, priv->track_count);
+        break;
+    case SEQ_SMF_PLAYER_PROP_QUEUE_ID:
+        g_value_set_uchar(val, priv->queue_id);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void seq_smf_player_finalize(GObject *obj)
+{
+    ALSASeqSmfPlayer *self = ALSASEQ_SMF_PLAYER(obj);
+    ALSASeqSmfPlayerPrivate *priv = alsaseq_smf_player_get_instance_private(self);
+
+    if (priv->client != NULL)
+        alsaseq_user_client_delete_queue(priv->client, priv->queue_id, NULL);
+    seq_smf_player_release_client(priv);
+    seq_smf_player_unload(priv);
+
+    g_boxed_free(ALSASEQ_TYPE_EVENT_CNTR, priv->ev_cntr);
+    g_object_unref(priv->pool);
+    g_byte_array_free(priv->blob, TRUE);
+
+    G_OBJECT_CLASS(alsaseq_smf_player_parent_class)->finalize(obj);
+}
+
+static void alsaseq_smf_player_class_init(ALSASeqSmfPlayerClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = seq_smf_player_finalize;
+    gobject_class->get_property = seq_smf_player_get_property;
+
+    /**
+     * ALSASeqSmfPlayer:format:
+     *
+     * The format of loaded file; 0 or 1.
+     */
+    seq_smf_player_props[SEQ_SMF_PLAYER_PROP_FORMAT] =
+        g_param_spec_uint("format", "format",
+                          "The format of loaded file.",
+                          0, G_MAXUINT16,
+                          0,
+                          G_PARAM_READABLE);
+
+    /**
+     * ALSASeqSmfPlayer:division:
+     *
+     * The number of ticks per quarter note in loaded file.
+     */
+    seq_smf_player_props[SEQ_SMF_PLAYER_PROP_DIVISION] =
+        g_param_spec_uint("division", "division",
+                          "The number of ticks per quarter note in loaded file.",
+                          0, G_MAXUINT16,
+                          0,
+                          G_PARAM_READABLE);
+
+    /**
+     * ALSASeqSmfPlayer:track-count:
+     *
+     * The number of tracks in loaded file.
+     */
+    seq_smf_player_props[SEQ_SMF_PLAYER_PROP_TRACK_COUNT] =
+        g_param_spec_uint("track-count", "track-count",
+                          "The number of tracks in loaded file.",
+                          0, G_MAXUINT16,
+                          0,
+                          G_PARAM_READABLE);
+
+    /**
+     * ALSASeqSmfPlayer:queue-id:
+     *
+     * The numeric ID of queue used for playback.
+     */
+    seq_smf_player_props[SEQ_SMF_PLAYER_PROP_QUEUE_ID] =
+        g_param_spec_uchar("queue-id", "queue-id",
+                           "The numeric ID of queue used for playback.",
+                           0, G_MAXUINT8,
+                           0,
+                           G_PARAM_READABLE);
+
+    g_object_class_install_properties(gobject_class, SEQ_SMF_PLAYER_PROP_COUNT,
+                                      seq_smf_player_props);
+
+    /**
+     * ALSASeqSmfPlayer::finished:
+     * @self: A [class@SmfPlayer].
+     *
+     * When all of events in the file are delivered, this signal is emit.
+     */
+    seq_smf_player_sigs[SEQ_SMF_PLAYER_SIG_TYPE_FINISHED] =
+        g_signal_new("finished",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqSmfPlayerClass, finished),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__VOID,
+                     G_TYPE_NONE, 0, G_TYPE_NONE);
+
+    /**
+     * ALSASeqSmfPlayer::playback-failed:
+     * @self: A [class@SmfPlayer].
+     * @error: A [struct@GLib.Error] with domain of `ALSASeq.UserClientError`.
+     *
+     * When the events in the next window of lookahead fail to be scheduled, the queue is stopped
+     * and deleted, then this signal is emit instead of [signal@SmfPlayer::finished] signal.
+     */
+    seq_smf_player_sigs[SEQ_SMF_PLAYER_SIG_TYPE_PLAYBACK_FAILED] =
+        g_signal_new("playback-failed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqSmfPlayerClass, playback_failed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__BOXED,
+                     G_TYPE_NONE, 1, G_TYPE_ERROR);
+}
+
+static void alsaseq_smf_player_init(ALSASeqSmfPlayer *self)
+{
+    ALSASeqSmfPlayerPrivate *priv = alsaseq_smf_player_get_instance_private(self);
+
+    priv->ev_cntr = alsaseq_event_cntr_new(0);
+    priv->pool = alsaseq_client_pool_new();
+    priv->blob = g_byte_array_new();
+}
+
+/**
+ * alsaseq_smf_player_new:
+ *
+ * Allocate and return an instance of [class@SmfPlayer].
+ *
+ * Returns: An instance of [class@SmfPlayer].
+ */
+ALSASeqSmfPlayer *alsaseq_smf_player_new()
+{
+    return g_object_new(ALSASEQ_TYPE_SMF_PLAYER, NULL);
+}
+
+static guint32 smf_read_be32(const guint8 *buf)
+{
+    return ((guint32)buf[0] << 24) | ((guint32)buf[1] << 16) | ((guint32)buf[2] << 8) | buf[3];
+}
+
+static guint16 smf_read_be16(const guint8 *buf)
+{
+    return ((guint16)buf[0] << 8) | buf[1];
+}
+
+// Read variable-length quantity. Return FALSE when it overruns the end.
+static gboolean smf_read_vlq(const guint8 **pos, const guint8 *end, guint32 *val)
+{
+    guint32 v = 0;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        if (*pos >= end)
+            return FALSE;
+        v = (v << 7) | (**pos & 0x7f);
+        if (!(*(*pos)++ & 0x80)) {
+            *val = v;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+// The track is at the end when the position reaches the end.
+static void smf_track_read_delta(SmfTrack *trk)
+{
+    guint32 delta;
+
+    if (!smf_read_vlq(&trk->pos, trk->end, &delta))
+        trk->pos = trk->end;
+    else
+        trk->tick += delta;
+}
+
+static gboolean smf_heap_less(const ALSASeqSmfPlayerPrivate *priv, guint lhs, guint rhs)
+{
+    const SmfTrack *l = priv->tracks + priv->heap[lhs];
+    const SmfTrack *r = priv->tracks + priv->heap[rhs];
+
+    // The order of tracks is kept for events at the same tick.
+    return l->tick < r->tick || (l->tick == r->tick && priv->heap[lhs] < priv->heap[rhs]);
+}
+
+static void smf_heap_swap(ALSASeqSmfPlayerPrivate *priv, guint lhs, guint rhs)
+{
+    guint tmp = priv->heap[lhs];
+
+    priv->heap[lhs] = priv->heap[rhs];
+    priv->heap[rhs] = tmp;
+}
+
+static void smf_heap_sift_down(ALSASeqSmfPlayerPrivate *priv, guint index)
+{
+    while (TRUE) {
+        guint least = index;
+        guint left = index * 2 + 1;
+        guint right = index * 2 + 2;
+
+        if (left < priv->heap_length && smf_heap_less(priv, left, least))
+            least = left;
+        if (right < priv->heap_length && smf_heap_less(priv, right, least))
+            least = right;
+        if (least == index)
+            break;
+
+        smf_heap_swap(priv, index, least);
+        index = least;
+    }
+}
+
+static void smf_heap_build(ALSASeqSmfPlayerPrivate *priv)
+{
+    guint i;
+
+    priv->heap_length = 0;
+    for (i = 0; i < priv->track_count; ++i) {
+        if (priv->tracks[i].pos < priv->tracks[i].end)
+            priv->heap[priv->heap_length++] = i;
+    }
+
+    for (i = priv->heap_length / 2; i > 0; --i)
+        smf_heap_sift_down(priv, i - 1);
+}
+
+// Update the top of heap after the track advanced.
+static void smf_heap_update_top(ALSASeqSmfPlayerPrivate *priv)
+{
+    const SmfTrack *trk = priv->tracks + priv->heap[0];
+
+    if (trk->pos >= trk->end) {
+        priv->heap[0] = priv->heap[--priv->heap_length];
+        if (priv->heap_length == 0)
+            return;
+    }
+
+    smf_heap_sift_down(priv, 0);
+}
+
+static void smf_rewind(ALSASeqSmfPlayerPrivate *priv)
+{
+    guint i;
+
+    for (i = 0; i < priv->track_count; ++i) {
+        SmfTrack *trk = priv->tracks + i;
+
+        trk->pos = priv->track_heads[i];
+        trk->end = priv->track_tails[i];
+        trk->tick = 0;
+        trk->running_status = 0;
+        smf_track_read_delta(trk);
+    }
+
+    smf_heap_build(priv);
+
+    priv->tempo = SMF_DEFAULT_TEMPO;
+    priv->last_tick = 0;
+    priv->last_time = 0;
+}
+
+/**
+ * alsaseq_smf_player_load:
+ * @self: A [class@SmfPlayer].
+ * @path: The path to Standard MIDI File.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.SmfPlayerError`.
+ *
+ * Map the file to memory and parse the header of file and tracks. The events in tracks are not
+ * parsed till scheduled.
+ *
+ * The call of function executes `open(2)`, `fstat(2)`, `mmap(2)`, and `close(2)` system calls.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_smf_player_load(ALSASeqSmfPlayer *self, const gchar *path, GError **error)
+{
+    ALSASeqSmfPlayerPrivate *priv;
+    struct stat st;
+    const guint8 *pos;
+    const guint8 *end;
+    guint32 header_length;
+    guint16 track_count;
+    int fd;
+
+    g_return_val_if_fail(ALSASEQ_IS_SMF_PLAYER(self), FALSE);
+    priv = alsaseq_smf_player_get_instance_private(self);
+
+    g_return_val_if_fail(priv->client == NULL, FALSE);
+    g_return_val_if_fail(path != NULL && strlen(path) > 0, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    seq_smf_player_unload(priv);
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        generate_file_error(error, errno, "open(%s)", path);
+        return FALSE;
+    }
+
+    if (fstat(fd, &st) < 0) {
+        generate_file_error(error, errno, "fstat(%s)", path);
+        close(fd);
+        return FALSE;
+    }
+
+    if (st.st_size < 14) {
+        close(fd);
+        generate_local_error(error, ALSASEQ_SMF_PLAYER_ERROR_INVALID_FORMAT,
+                             "The file is too short");
+        return FALSE;
+    }
+
+    priv->map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (priv->map == MAP_FAILED) {
+        priv->map = NULL;
+        generate_file_error(error, errno, "mmap(%s)", path);
+        close(fd);
+        return FALSE;
+    }
+    close(fd);
+    priv->map_size = st.st_size;
+
+    pos = priv->map;
+    end = priv->map + priv->map_size;
+
+    header_length = smf_read_be32(pos + 4);
+    if (memcmp(pos, "MThd", 4) != 0 || header_length < 6 || header_length > priv->map_size - 8) {
+        seq_smf_player_unload(priv);
+        generate_local_error(error, ALSASEQ_SMF_PLAYER_ERROR_INVALID_FORMAT,
+                             "The header chunk is invalid");
+        return FALSE;
+    }
+
+    priv->format = smf_read_be16(pos + 8);
+    track_count = smf_read_be16(pos + 10);
+    priv->division = smf_read_be16(pos + 12);
+    if (priv->format > 1) {
+        seq_smf_player_unload(priv);
+        generate_local_error(error, ALSASEQ_SMF_PLAYER_ERROR_INVALID_FORMAT,
+                             "The format is not supported");
+        return FALSE;
+    }
+
+    // The division of time code is not supported.
+    if (priv->division == 0 || priv->division & 0x8000) {
+        seq_smf_player_unload(priv);
+        generate_local_error(error, ALSASEQ_SMF_PLAYER_ERROR_UNSUPPORTED_DIVISION,
+                             "The division of time code is not supported");
+        return FALSE;
+    }
+
+    priv->tracks = g_new0(SmfTrack, track_count);
+    priv->track_heads = g_new0(const guint8 *, track_count);
+    priv->track_tails = g_new0(const guint8 *, track_count);
+    priv->heap = g_new0(guint, track_count);
+
+    // The chunks with unknown type are skipped.
+    pos += 8 + header_length;
+    while (priv->track_count < track_count && end - pos >= 8) {
+        guint32 length = smf_read_be32(pos + 4);
+
+        if (length > end - pos - 8)
+            break;
+
+        if (memcmp(pos, "MTrk", 4) == 0) {
+            priv->track_heads[priv->track_count] = pos + 8;
+            priv->track_tails[priv->track_count] = pos + 8 + length;
+            ++priv->track_count;
+        }
+
+        pos += 8 + length;
+    }
+
+    if (priv->track_count < track_count) {
+        seq_smf_player_unload(priv);
+        generate_local_error(error, ALSASEQ_SMF_PLAYER_ERROR_INVALID_FORMAT,
+                             "The track chunk is truncated");
+        return FALSE;
+    }
+
+    // Each track is read sequentially.
+    madvise(priv->map, priv->map_size, MADV_SEQUENTIAL);
+
+    smf_rewind(priv);
+
+    return TRUE;
+}
+
+// Return the time in nanosecond unit for the tick, with the tempo at the last tick.
+static guint64 smf_tick_to_time(const ALSASeqSmfPlayerPrivate *priv, guint64 tick)
+{
+    return priv->last_time + (tick - priv->last_tick) * priv->tempo * 1000 / priv->division;
+}
+
+static void smf_prepare_event(const ALSASeqSmfPlayerPrivate *priv, struct snd_seq_event *ev,
+                              guint64 tick)
+{
+    memset(ev, 0, sizeof(*ev));
+    ev->flags = SNDRV_SEQ_TIME_STAMP_TICK | SNDRV_SEQ_TIME_MODE_ABS | SNDRV_SEQ_EVENT_LENGTH_FIXED;
+    ev->queue = priv->queue_id;
+    ev->time.tick = tick;
+    ev->source.port = priv->port_id;
+    ev->dest.client = SNDRV_SEQ_ADDRESS_SUBSCRIBERS;
+    ev->dest.port = SNDRV_SEQ_ADDRESS_UNKNOWN;
+}
+
+// Decode the event at the top of track into the sequencer event. Return FALSE when the event is
+// not delivered.
+static gboolean smf_decode_event(ALSASeqSmfPlayerPrivate *priv, SmfTrack *trk,
+                                 struct snd_seq_event *ev)
+{
+    guint8 status;
+    guint32 length;
+
+    smf_prepare_event(priv, ev, trk->tick);
+
+    status = *trk->pos;
+    if (status & 0x80) {
+        ++trk->pos;
+    } else {
+        // Running status.
+        if (trk->running_status == 0)
+            goto malformed;
+        status = trk->running_status;
+    }
+
+    if (status < 0xf0) {
+        guint8 data[2] = { 0 };
+        guint count = ((status & 0xf0) == 0xc0 || (status & 0xf0) == 0xd0) ? 1 : 2;
+
+        if (trk->end - trk->pos < count)
+            goto malformed;
+        memcpy(data, trk->pos, count);
+        trk->pos += count;
+        trk->running_status = status;
+
+        switch (status & 0xf0) {
+        case 0x80:
+        case 0x90:
+        case 0xa0:
+            ev->type = (status & 0xf0) == 0x80 ? SNDRV_SEQ_EVENT_NOTEOFF :
+                       (status & 0xf0) == 0x90 ? SNDRV_SEQ_EVENT_NOTEON : SNDRV_SEQ_EVENT_KEYPRESS;
+            ev->data.note.channel = status & 0x0f;
+            ev->data.note.note = data[0];
+            ev->data.note.velocity = data[1];
+            break;
+        case 0xb0:
+            ev->type = SNDRV_SEQ_EVENT_CONTROLLER;
+            ev->data.control.channel = status & 0x0f;
+            ev->data.control.param = data[0];
+            ev->data.control.value = data[1];
+            break;
+        case 0xc0:
+            ev->type = SNDRV_SEQ_EVENT_PGMCHANGE;
+            ev->data.control.channel = status & 0x0f;
+            ev->data.control.value = data[0];
+            break;
+        case 0xd0:
+            ev->type = SNDRV_SEQ_EVENT_CHANPRESS;
+            ev->data.control.channel = status & 0x0f;
+            ev->data.control.value = data[0];
+            break;
+        default:
+            ev->type = SNDRV_SEQ_EVENT_PITCHBEND;
+            ev->data.control.channel = status & 0x0f;
+            ev->data.control.value = ((data[1] << 7) | data[0]) - 8192;
+            break;
+        }
+
+        return TRUE;
+    }
+
+    // System messages cancel running status.
+    trk->running_status = 0;
+
+    if (status == 0xff) {
+        guint8 type;
+
+        if (trk->pos >= trk->end)
+            goto malformed;
+        type = *trk->pos++;
+        if (!smf_read_vlq(&trk->pos, trk->end, &length) || length > trk->end - trk->pos)
+            goto malformed;
+
+        if (type == 0x2f) {
+            // End of track.
+            trk->pos = trk->end;
+            return FALSE;
+        }
+
+        if (type == 0x51 && length == 3) {
+            ev->type = SNDRV_SEQ_EVENT_TEMPO;
+            ev->dest.client = SNDRV_SEQ_CLIENT_SYSTEM;
+            ev->dest.port = SNDRV_SEQ_PORT_SYSTEM_TIMER;
+            ev->data.queue.queue = priv->queue_id;
+            ev->data.queue.param.value =
+                    ((guint32)trk->pos[0] << 16) | ((guint32)trk->pos[1] << 8) | trk->pos[2];
+            trk->pos += length;
+            return TRUE;
+        }
+
+        trk->pos += length;
+        return FALSE;
+    }
+
+    if (status == 0xf0 || status == 0xf7) {
+        if (!smf_read_vlq(&trk->pos, trk->end, &length) || length > trk->end - trk->pos)
+            goto malformed;
+
+        // The leading byte is not included in the file.
+        g_byte_array_set_size(priv->blob, 0);
+        if (status == 0xf0)
+            g_byte_array_append(priv->blob, &status, 1);
+        g_byte_array_append(priv->blob, trk->pos, length);
+        trk->pos += length;
+
+        if (priv->blob->len == 0)
+            return FALSE;
+
+        ev->type = SNDRV_SEQ_EVENT_SYSEX;
+        ev->flags &= ~SNDRV_SEQ_EVENT_LENGTH_MASK;
+        ev->flags |= SNDRV_SEQ_EVENT_LENGTH_VARIABLE;
+        ev->data.ext.len = priv->blob->len;
+        ev->data.ext.ptr = priv->blob->data;
+        return TRUE;
+    }
+malformed:
+    // The rest of track is discarded.
+    trk->pos = trk->end;
+    return FALSE;
+}
+
+static gboolean seq_smf_player_schedule_echo(ALSASeqSmfPlayerPrivate *priv, guint64 tick,
+                                             GError **error)
+{
+    struct snd_seq_event ev;
+
+    smf_prepare_event(priv, &ev, tick);
+    ev.type = SNDRV_SEQ_EVENT_ECHO;
+    ev.dest.client = priv->client_id;
+    ev.dest.port = priv->port_id;
+    ev.data.raw32.d[0] = SMF_ECHO_MAGIC;
+    ev.data.raw32.d[1] = priv->queue_id;
+
+    return alsaseq_user_client_schedule_event(priv->client, &ev, error);
+}
+
+// Schedule the events in the window of lookahead, then schedule the echo event to refill at the
+// middle of window.
+static gboolean seq_smf_player_refill(ALSASeqSmfPlayerPrivate *priv, GError **error)
+{
+    struct snd_seq_queue_status status = {0};
+    guint64 now;
+    guint64 echo_tick;
+    gboolean echo_found;
+    guint output_free;
+    gsize cells;
+    gsize count;
+
+    status.queue = priv->queue_id;
+    if (ioctl(seq_user_client_get_fd(priv->client), SNDRV_SEQ_IOCTL_GET_QUEUE_STATUS,
+              &status) < 0) {
+        generate_file_error(error, errno, "ioctl(%s)", "GET_QUEUE_STATUS");
+        return FALSE;
+    }
+    now = status.time.tv_sec * G_GUINT64_CONSTANT(1000000000) + status.time.tv_nsec;
+
+    if (!alsaseq_user_client_get_pool(priv->client, &priv->pool, error))
+        return FALSE;
+    g_object_get(priv->pool, "output-free", &output_free, NULL);
+
+    // A cell is reserved for the echo event.
+    cells = output_free > 0 ? output_free - 1 : 0;
+
+    alsaseq_event_cntr_clear(priv->ev_cntr);
+    echo_tick = priv->last_tick;
+    echo_found = FALSE;
+
+    while (priv->heap_length > 0) {
+        SmfTrack *trk = priv->tracks + priv->heap[0];
+        guint64 time = smf_tick_to_time(priv, trk->tick);
+        SmfTrack saved = *trk;
+        struct snd_seq_event ev;
+        gboolean decoded;
+
+        if (time >= now + priv->lookahead)
+            break;
+
+        decoded = smf_decode_event(priv, trk, &ev);
+        if (decoded) {
+            gsize consumption = seq_event_calculate_flattened_length(&ev, TRUE) / sizeof(ev);
+
+            if (consumption > cells) {
+                *trk = saved;
+                break;
+            }
+
+            if (!alsaseq_event_cntr_append_event(priv->ev_cntr, &ev, error))
+                return FALSE;
+            cells -= consumption;
+        }
+
+        // The tempo is applied to the time after the event.
+        priv->last_time = time;
+        priv->last_tick = saved.tick;
+        if (decoded && ev.type == SNDRV_SEQ_EVENT_TEMPO)
+            priv->tempo = ev.data.queue.param.value;
+
+        if (!echo_found && time >= now + priv->lookahead / 2) {
+            echo_tick = priv->last_tick;
+            echo_found = TRUE;
+        }
+
+        if (trk->pos < trk->end)
+            smf_track_read_delta(trk);
+        smf_heap_update_top(priv);
+    }
+
+    // Avoid the echo event delivered immediately when no event is in the middle of window.
+    if (!echo_found && priv->heap_length > 0 && now + priv->lookahead / 2 > priv->last_time) {
+        guint64 delta = now + priv->lookahead / 2 - priv->last_time;
+
+        echo_tick = priv->last_tick + delta * priv->division / ((guint64)priv->tempo * 1000);
+    }
+
+    if (!alsaseq_user_client_schedule_event_cntr(priv->client, priv->ev_cntr, &count, error))
+        return FALSE;
+
+    return seq_smf_player_schedule_echo(priv, echo_tick, error);
+}
+
+static void seq_smf_player_handle_echo(ALSASeqUserClient *client, const ALSASeqEvent *event,
+                                       gpointer user_data)
+{
+    ALSASeqSmfPlayer *self = ALSASEQ_SMF_PLAYER(user_data);
+    ALSASeqSmfPlayerPrivate *priv = alsaseq_smf_player_get_instance_private(self);
+    const struct snd_seq_event *ev = (const struct snd_seq_event *)event;
+    GError *error = NULL;
+
+    if (ev->source.client != priv->client_id || ev->data.raw32.d[0] != SMF_ECHO_MAGIC ||
+        ev->data.raw32.d[1] != priv->queue_id)
+        return;
+
+    if (priv->heap_length == 0) {
+        g_signal_emit(self, seq_smf_player_sigs[SEQ_SMF_PLAYER_SIG_TYPE_FINISHED], 0);
+        return;
+    }
+
+    if (!seq_smf_player_refill(priv, &error)) {
+        alsaseq_smf_player_stop(self, NULL);
+        g_signal_emit(self, seq_smf_player_sigs[SEQ_SMF_PLAYER_SIG_TYPE_PLAYBACK_FAILED], 0,
+                      error);
+        g_error_free(error);
+    }
+}
+
+/**
+ * alsaseq_smf_player_start:
+ * @self: A [class@SmfPlayer].
+ * @client: A [class@UserClient] to schedule events.
+ * @port_id: The numeric ID of port in the client. The events are delivered to subscribers of the
+ *           port, thus the port should have [flags@PortCapFlag].READ and
+ *           [flags@PortCapFlag].SUBS_READ. The port should have [flags@PortCapFlag].WRITE as
+ *           well to receive the echo event.
+ * @lookahead: The window of lookahead in millisecond unit.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Create a queue with the division of loaded file, schedule the events in the window of
+ * lookahead as well as the echo event to refill the window, then start the queue. The number of
+ * events scheduled at once is bounded by [property@ClientPool:output-free] as well.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_smf_player_start(ALSASeqSmfPlayer *self, ALSASeqUserClient *client,
+                                  guint8 port_id, guint lookahead, GError **error)
+{
+    ALSASeqSmfPlayerPrivate *priv;
+    ALSASeqQueueInfo *queue_info;
+    ALSASeqQueueTempo *queue_tempo;
+    gboolean result;
+
+    g_return_val_if_fail(ALSASEQ_IS_SMF_PLAYER(self), FALSE);
+    priv = alsaseq_smf_player_get_instance_private(self);
+
+    g_return_val_if_fail(priv->map != NULL, FALSE);
+    g_return_val_if_fail(priv->client == NULL, FALSE);
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(client), FALSE);
+    g_return_val_if_fail(lookahead > 0, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    queue_info = alsaseq_queue_info_new();
+    result = alsaseq_user_client_create_queue(client, &queue_info, error);
+    if (result)
+        g_object_get(queue_info, "queue-id", &priv->queue_id, NULL);
+    g_object_unref(queue_info);
+    if (!result)
+        return FALSE;
+
+    priv->client = g_object_ref(client);
+    g_object_get(client, "client-id", &priv->client_id, NULL);
+    priv->port_id = port_id;
+    priv->lookahead = lookahead * G_GUINT64_CONSTANT(1000000);
+
+    queue_tempo = alsaseq_queue_tempo_new();
+    g_object_set(queue_tempo, "tempo", SMF_DEFAULT_TEMPO, "resolution", priv->division, NULL);
+    result = alsaseq_user_client_set_queue_tempo(client, priv->queue_id, queue_tempo, error);
+    g_object_unref(queue_tempo);
+    if (!result)
+        goto failed;
+
+    smf_rewind(priv);
+
+    // The player can be finalized before the client.
+    priv->handler_id = g_signal_connect_object(client, "handle-typed-event::echo",
+                                               (GCallback)seq_smf_player_handle_echo, self, 0);
+
+    if (!seq_smf_player_refill(priv, error))
+        goto failed;
+
+    if (!seq_user_client_control_queue(priv->client, priv->queue_id, SNDRV_SEQ_EVENT_START,
+                                       error))
+        goto failed;
+
+    return TRUE;
+failed:
+    alsaseq_user_client_delete_queue(client, priv->queue_id, NULL);
+    seq_smf_player_release_client(priv);
+    return FALSE;
+}
+
+/**
+ * alsaseq_smf_player_stop:
+ * @self: A [class@SmfPlayer].
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
+ *
+ * Stop the queue and delete it, then the events scheduled in the queue are discarded.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_smf_player_stop(ALSASeqSmfPlayer *self, GError **error)
+{
+    ALSASeqSmfPlayerPrivate *priv;
+    gboolean result;
+
+    g_return_val_if_fail(ALSASEQ_IS_SMF_PLAYER(self), FALSE);
+    priv = alsaseq_smf_player_get_instance_private(self);
+
+    g_return_val_if_fail(priv->client != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    result = seq_user_client_control_queue(priv->client, priv->queue_id, SNDRV_SEQ_EVENT_STOP,
+                                           error);
+    if (result)
+        result = alsaseq_user_client_delete_queue(priv->client, priv->queue_id, error);
+    else
+        alsaseq_user_client_delete_queue(priv->client, priv->queue_id, NULL);
+
+    seq_smf_player_release_client(priv);
+
+    return result;
+}
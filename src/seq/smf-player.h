@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_SMF_PLAYER_H__
+#define __ALSA_GOBJECT_ALSASEQ_SMF_PLAYER_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_SMF_PLAYER     (alsaseq_smf_player_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(ALSASeqSmfPlayer, alsaseq_smf_player, ALSASEQ, SMF_PLAYER, GObject);
+
+#define ALSASEQ_SMF_PLAYER_ERROR    alsaseq_smf_player_error_quark()
+
+GQuark alsaseq_smf_player_error_quark();
+
+struct _ALSASeqSmfPlayerClass {
+    GObjectClass parent_class;
+
+    /**
+     * ALSASeqSmfPlayerClass::finished:
+     * @self: A [class@SmfPlayer].
+     *
+     * Class closure for the [signal@SmfPlayer::finished] signal.
+     */
+    void (*finished)(ALSASeqSmfPlayer *self);
+
+    /**
+     * ALSASeqSmfPlayerClass::playback_failed:
+     * @self: A [class@SmfPlayer].
+     * @error: A [struct@GLib.Error] with domain of `ALSASeq.UserClientError`.
+     *
+     * Class closure for the [signal@SmfPlayer::playback-failed] signal.
+     */
+    void (*playback_failed)(ALSASeqSmfPlayer *self, const GError *error);
+};
+
+ALSASeqSmfPlayer *alsaseq_smf_player_new();
+
+gboolean alsaseq_smf_player_load(ALSASeqSmfPlayer *self, const gchar *path, GError **error);
+
+gboolean alsaseq_smf_player_start(ALSASeqSmfPlayer *self, ALSASeqUserClient *client,
+                                  guint8 port_id, guint lookahead, GError **error);
+
+gboolean alsaseq_smf_player_stop(ALSASeqSmfPlayer *self, GError **error);
+
+G_END_DECLS
+
+#endif
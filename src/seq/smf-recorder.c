@@ -0,0 +1,511 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+#include <utils.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+/**
+ * ALSASeqSmfRecorder:
+ * A GObject-derived object to record events into Standard MIDI File.
+ *
+ * A [class@SmfRecorder] is a GObject-derived object to record events into Standard MIDI File
+ * (format 0). The recorder establishes the subscription with time stamp in tick of queue, then
+ * encodes the events in the flattened buffer received by [signal@UserClient::handle-event]
+ * signal into the track data without allocation per event. The track data is accumulated in
+ * a fixed-size buffer and written to the file when the buffer is full. The length of track in the
+ * file is finalized by [method@SmfRecorder.stop].
+ */
+typedef struct {
+    ALSASeqUserClient *client;
+    guint8 port_id;
+    guint8 queue_id;
+    struct snd_seq_addr sender;
+    gulong handler_id;
+
+    int fd;
+    guint8 *buf;
+    gsize length;
+    guint64 total;
+    int write_errno;
+
+    guint32 last_tick;
+    guint8 running_status;
+    guint64 event_count;
+} ALSASeqSmfRecorderPrivate;
+G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqSmfRecorder, alsaseq_smf_recorder, G_TYPE_OBJECT)
+
+// The size of buffer to accumulate track data.
+#define SMF_RECORDER_BUFFER_SIZE    65536
+
+// The offset of length field in the chunk of track.
+#define SMF_TRACK_LENGTH_OFFSET     18
+#define SMF_TRACK_DATA_OFFSET       22
+
+enum seq_smf_recorder_prop_type {
+    SEQ_SMF_RECORDER_PROP_QUEUE_ID = 1,
+    SEQ_SMF_RECORDER_PROP_EVENT_COUNT,
+    SEQ_SMF_RECORDER_PROP_COUNT,
+};
+static GParamSpec *seq_smf_recorder_props[SEQ_SMF_RECORDER_PROP_COUNT] = { NULL, };
+
+static void seq_smf_recorder_release(ALSASeqSmfRecorderPrivate *priv)
+{
+    if (priv->client != NULL) {
+        g_signal_handler_disconnect(priv->client, priv->handler_id);
+        alsaseq_user_client_delete_queue(priv->client, priv->queue_id, NULL);
+        g_object_unref(priv->client);
+    }
+    priv->client = NULL;
+    priv->handler_id = 0;
+
+    if (priv->fd >= 0)
+        close(priv->fd);
+    priv->fd = -1;
+}
+
+static void seq_smf_recorder_get_property(GObject *obj, guint id, GValue *val, GParamSpec *spec)
+{
+    ALSASeqSmfRecorder *self = ALSASEQ_SMF_RECORDER(obj);
+    ALSASeqSmfRecorderPrivate *priv = alsaseq_smf_recorder_get_instance_private(self);
+
+    switch (id) {
+    case SEQ_SMF_RECORDER_PROP_QUEUE_ID:
+        g_value_set_uchar(val, priv->queue_id);
+        break;
+    case SEQ_SMF_RECORDER_PROP_EVENT_COUNT:
+        g_value_set_uint64(val, priv->event_count);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void seq_smf_recorder_finalize(GObject *obj)
+{
+    ALSASeqSmfRecorder *self = ALSASEQ_SMF_RECORDER(obj);
+    ALSASeqSmfRecorderPrivate *priv = alsaseq_smf_recorder_get_instance_private(self);
+
+    seq_smf_recorder_release(priv);
+    g_free(priv->buf);
+
+    G_OBJECT_CLASS(alsaseq_smf_recorder_parent_class)->finalize(obj);
+}
+
+static void alsaseq_smf_recorder_class_init(ALSASeqSmfRecorderClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = seq_smf_recorder_finalize;
+    gobject_class->get_property = seq_smf_recorder_get_property;
+
+    /**
+     * ALSASeqSmfRecorder:queue-id:
+     *
+     * The numeric ID of queue used for time stamp.
+     */
+    seq_smf_recorder_props[SEQ_SMF_RECORDER_PROP_QUEUE_ID] =
+        g_param_spec_uchar("queue-id", "queue-id",
+                           "The numeric ID of queue used for time stamp.",
+                           0, G_MAXUINT8,
+                           0,
+                           G_PARAM_READABLE);
+
+    /**
+     * ALSASeqSmfRecorder:event-count:
+     *
+     * The number of events recorded.
+     */
+    seq_smf_recorder_props[SEQ_SMF_RECORDER_PROP_EVENT_COUNT] =
+        g_param_spec_uint64("event-count", "event-count",
+                            "The number of events recorded.",
+                            0, G_MAXUINT64,
+                            0,
+                            G_PARAM_READABLE);
+
+    g_object_class_install_properties(gobject_class, SEQ_SMF_RECORDER_PROP_COUNT,
+                                      seq_smf_recorder_props);
+}
+
+static void alsaseq_smf_recorder_init(ALSASeqSmfRecorder *self)
+{
+    ALSASeqSmfRecorderPrivate *priv = alsaseq_smf_recorder_get_instance_private(self);
+
+    priv->fd = -1;
+    priv->buf = g_malloc(SMF_RECORDER_BUFFER_SIZE);
+}
+
+/**
+ * alsaseq_smf_recorder_new:
+ *
+ * Allocate and return an instance of [class@SmfRecorder].
+ *
+ * Returns: An instance of [class@SmfRecorder].
+ */
+ALSASeqSmfRecorder *alsaseq_smf_recorder_new()
+{
+    return g_object_new(ALSASEQ_TYPE_SMF_RECORDER, NULL);
+}
+
+static void smf_write_all(ALSASeqSmfRecorderPrivate *priv, const guint8 *data, gsize length)
+{
+    while (length > 0 && priv->write_errno == 0) {
+        ssize_t result = write(priv->fd, data, length);
+
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            // The first error is reported when stopped.
+            priv->write_errno = errno;
+            break;
+        }
+
+        data += result;
+        length -= result;
+    }
+}
+
+static void smf_flush(ALSASeqSmfRecorderPrivate *priv)
+{
+    smf_write_all(priv, priv->buf, priv->length);
+    priv->length = 0;
+}
+
+static void smf_put(ALSASeqSmfRecorderPrivate *priv, const guint8 *data, gsize length)
+{
+    if (priv->length + length > SMF_RECORDER_BUFFER_SIZE)
+        smf_flush(priv);
+
+    if (length > SMF_RECORDER_BUFFER_SIZE) {
+        smf_write_all(priv, data, length);
+    } else {
+        memcpy(priv->buf + priv->length, data, length);
+        priv->length += length;
+    }
+
+    priv->total += length;
+}
+
+static void smf_put_vlq(ALSASeqSmfRecorderPrivate *priv, guint32 val)
+{
+    guint8 data[5];
+    gsize pos = sizeof(data);
+
+    data[--pos] = val & 0x7f;
+    while ((val >>= 7) > 0)
+        data[--pos] = 0x80 | (val & 0x7f);
+
+    smf_put(priv, data + pos, sizeof(data) - pos);
+}
+
+static void smf_put_be32(guint8 *buf, guint32 val)
+{
+    buf[0] = (val >> 24) & 0xff;
+    buf[1] = (val >> 16) & 0xff;
+    buf[2] = (val >> 8) & 0xff;
+    buf[3] = val & 0xff;
+}
+
+static void smf_put_delta(ALSASeqSmfRecorderPrivate *priv, guint32 tick)
+{
+    guint32 delta = 0;
+
+    // The time stamp can be behind in the case that the queue is shared.
+    if (tick > priv->last_tick) {
+        delta = tick - priv->last_tick;
+        priv->last_tick = tick;
+    }
+
+    smf_put_vlq(priv, delta);
+}
+
+static void smf_put_channel_message(ALSASeqSmfRecorderPrivate *priv, guint32 tick, guint8 status,
+                                    const guint8 *data, gsize length)
+{
+    smf_put_delta(priv, tick);
+
+    if (status != priv->running_status) {
+        smf_put(priv, &status, 1);
+        priv->running_status = status;
+    }
+    smf_put(priv, data, length);
+}
+
+// Encode the event into track data. Return FALSE when the event is not recorded.
+static gboolean smf_encode_event(ALSASeqSmfRecorderPrivate *priv, const struct snd_seq_event *ev)
+{
+    guint32 tick = ev->time.tick;
+    guint8 data[2];
+
+    switch (ev->type) {
+    case SNDRV_SEQ_EVENT_NOTEON:
+    case SNDRV_SEQ_EVENT_NOTEOFF:
+    case SNDRV_SEQ_EVENT_KEYPRESS:
+    {
+        guint8 status = ev->type == SNDRV_SEQ_EVENT_NOTEON ? 0x90 :
+                        ev->type == SNDRV_SEQ_EVENT_NOTEOFF ? 0x80 : 0xa0;
+
+        data[0] = ev->data.note.note & 0x7f;
+        data[1] = ev->data.note.velocity & 0x7f;
+        smf_put_channel_message(priv, tick, status | (ev->data.note.channel & 0x0f), data, 2);
+        return TRUE;
+    }
+    case SNDRV_SEQ_EVENT_CONTROLLER:
+        data[0] = ev->data.control.param & 0x7f;
+        data[1] = ev->data.control.value & 0x7f;
+        smf_put_channel_message(priv, tick, 0xb0 | (ev->data.control.channel & 0x0f), data, 2);
+        return TRUE;
+    case SNDRV_SEQ_EVENT_PGMCHANGE:
+        data[0] = ev->data.control.value & 0x7f;
+        smf_put_channel_message(priv, tick, 0xc0 | (ev->data.control.channel & 0x0f), data, 1);
+        return TRUE;
+    case SNDRV_SEQ_EVENT_CHANPRESS:
+        data[0] = ev->data.control.value & 0x7f;
+        smf_put_channel_message(priv, tick, 0xd0 | (ev->data.control.channel & 0x0f), data, 1);
+        return TRUE;
+    case SNDRV_SEQ_EVENT_PITCHBEND:
+    {
+        guint value = CLAMP(ev->data.control.value + 8192, 0, 16383);
+
+        data[0] = value & 0x7f;
+        data[1] = (value >> 7) & 0x7f;
+        smf_put_channel_message(priv, tick, 0xe0 | (ev->data.control.channel & 0x0f), data, 2);
+        return TRUE;
+    }
+    case SNDRV_SEQ_EVENT_SYSEX:
+    {
+        // NOTE: the event is followed by the blob in the flattened layout.
+        const guint8 *blob = (const guint8 *)(ev + 1);
+        guint32 length = ev->data.ext.len;
+        guint8 status;
+
+        if ((ev->flags & SNDRV_SEQ_EVENT_LENGTH_MASK) != SNDRV_SEQ_EVENT_LENGTH_VARIABLE ||
+            length == 0)
+            return FALSE;
+
+        // The leading byte of system exclusive message is not included in the length.
+        if (blob[0] == 0xf0) {
+            status = 0xf0;
+            ++blob;
+            --length;
+        } else {
+            status = 0xf7;
+        }
+
+        smf_put_delta(priv, tick);
+        smf_put(priv, &status, 1);
+        smf_put_vlq(priv, length);
+        smf_put(priv, blob, length);
+
+        // System messages cancel running status.
+        priv->running_status = 0;
+        return TRUE;
+    }
+    default:
+        return FALSE;
+    }
+}
+
+static void seq_smf_recorder_handle_event(ALSASeqUserClient *client,
+                                          const ALSASeqEventCntr *ev_cntr, gpointer user_data)
+{
+    ALSASeqSmfRecorder *self = ALSASEQ_SMF_RECORDER(user_data);
+    ALSASeqSmfRecorderPrivate *priv = alsaseq_smf_recorder_get_instance_private(self);
+    gsize pos = 0;
+
+    while (pos + sizeof(struct snd_seq_event) <= ev_cntr->length) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)(ev_cntr->buf + pos);
+
+        // The event delivered directly to the port is not stamped by the subscription. The
+        // event stamped in real time or by the other queue is not recorded.
+        if (ev->dest.port == priv->port_id && ev->source.client == priv->sender.client &&
+            ev->source.port == priv->sender.port &&
+            (ev->flags & SNDRV_SEQ_TIME_STAMP_MASK) == SNDRV_SEQ_TIME_STAMP_TICK &&
+            ev->queue == priv->queue_id && smf_encode_event(priv, ev))
+            ++priv->event_count;
+
+        pos += seq_event_calculate_flattened_length(ev, ev_cntr->aligned);
+    }
+}
+
+static gboolean seq_smf_recorder_operate_subscription(ALSASeqSmfRecorderPrivate *priv,
+                                                      gboolean establish, GError **error)
+{
+    ALSASeqSubscribeData *subs_data;
+    ALSASeqAddr *dest;
+    gboolean result;
+
+    dest = alsaseq_addr_new(0, priv->port_id);
+    g_object_get(priv->client, "client-id", &dest->client, NULL);
+
+    subs_data = alsaseq_subscribe_data_new();
+    g_object_set(subs_data,
+                 "sender", &priv->sender,
+                 "dest", dest,
+                 "has-tstamp", TRUE,
+                 "tstamp-mode", ALSASEQ_EVENT_TSTAMP_MODE_TICK,
+                 "queue-id", priv->queue_id,
+                 NULL);
+    g_boxed_free(ALSASEQ_TYPE_ADDR, dest);
+
+    result = alsaseq_user_client_operate_subscription(priv->client, subs_data, establish, error);
+    g_object_unref(subs_data);
+
+    return result;
+}
+
+/**
+ * alsaseq_smf_recorder_start:
+ * @self: A [class@SmfRecorder].
+ * @client: A [class@UserClient] to receive events.
+ * @port_id: The numeric ID of port in the client to receive events. The port should have
+ *           [flags@PortCapFlag].WRITE.
+ * @sender: The address of port to record events.
+ * @path: The path to Standard MIDI File to write.
+ * @division: The number of ticks per quarter note.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Create the file and write the header, create a queue with the division, establish the
+ * subscription from the sender to the port with time stamp in tick of the queue, then start the
+ * queue. The source of client should be attached to [struct@GLib.MainContext] to receive events.
+ * The events without time stamp in tick of the queue are not recorded.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_smf_recorder_start(ALSASeqSmfRecorder *self, ALSASeqUserClient *client,
+                                    guint8 port_id, const ALSASeqAddr *sender, const gchar *path,
+                                    guint16 division, GError **error)
+{
+    static const guint8 header[] = {
+        'M', 'T', 'h', 'd', 0x00, 0x00, 0x00, 0x06,
+        0x00, 0x00,     // format 0.
+        0x00, 0x01,     // single track.
+        0x00, 0x00,     // division.
+        'M', 'T', 'r', 'k', 0x00, 0x00, 0x00, 0x00,
+    };
+    ALSASeqSmfRecorderPrivate *priv;
+    ALSASeqQueueInfo *queue_info;
+    ALSASeqQueueTempo *queue_tempo;
+    gboolean result;
+
+    g_return_val_if_fail(ALSASEQ_IS_SMF_RECORDER(self), FALSE);
+    priv = alsaseq_smf_recorder_get_instance_private(self);
+
+    g_return_val_if_fail(priv->client == NULL, FALSE);
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(client), FALSE);
+    g_return_val_if_fail(sender != NULL, FALSE);
+    g_return_val_if_fail(path != NULL && strlen(path) > 0, FALSE);
+    g_return_val_if_fail(division > 0 && division < 0x8000, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (priv->fd < 0) {
+        generate_file_error(error, errno, "open(%s)", path);
+        return FALSE;
+    }
+
+    priv->length = 0;
+    priv->total = 0;
+    priv->write_errno = 0;
+    priv->last_tick = 0;
+    priv->running_status = 0;
+    priv->event_count = 0;
+
+    smf_put(priv, header, sizeof(header));
+    priv->buf[12] = (division >> 8) & 0xff;
+    priv->buf[13] = division & 0xff;
+
+    queue_info = alsaseq_queue_info_new();
+    result = alsaseq_user_client_create_queue(client, &queue_info, error);
+    if (result)
+        g_object_get(queue_info, "queue-id", &priv->queue_id, NULL);
+    g_object_unref(queue_info);
+    if (!result) {
+        close(priv->fd);
+        priv->fd = -1;
+        return FALSE;
+    }
+
+    priv->client = g_object_ref(client);
+    priv->port_id = port_id;
+    priv->sender = *sender;
+
+    queue_tempo = alsaseq_queue_tempo_new();
+    g_object_set(queue_tempo, "tempo", SMF_DEFAULT_TEMPO, "resolution", division, NULL);
+    result = alsaseq_user_client_set_queue_tempo(client, priv->queue_id, queue_tempo, error);
+    g_object_unref(queue_tempo);
+    if (!result)
+        goto failed;
+
+    // The recorder can be finalized before the client.
+    priv->handler_id = g_signal_connect_object(client, "handle-event",
+                                               (GCallback)seq_smf_recorder_handle_event, self, 0);
+
+    if (!seq_smf_recorder_operate_subscription(priv, TRUE, error))
+        goto failed;
+
+    if (!seq_user_client_control_queue(client, priv->queue_id, SNDRV_SEQ_EVENT_START, error)) {
+        seq_smf_recorder_operate_subscription(priv, FALSE, NULL);
+        goto failed;
+    }
+
+    return TRUE;
+failed:
+    seq_smf_recorder_release(priv);
+    return FALSE;
+}
+
+/**
+ * alsaseq_smf_recorder_stop:
+ * @self: A [class@SmfRecorder].
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Break the subscription, stop and delete the queue, then write the end of track and finalize
+ * the length of track in the file. The error at writing the file during the recording is
+ * reported as well.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_smf_recorder_stop(ALSASeqSmfRecorder *self, GError **error)
+{
+    static const guint8 end_of_track[] = { 0x00, 0xff, 0x2f, 0x00 };
+    ALSASeqSmfRecorderPrivate *priv;
+    guint8 track_length[4];
+    gboolean result;
+
+    g_return_val_if_fail(ALSASEQ_IS_SMF_RECORDER(self), FALSE);
+    priv = alsaseq_smf_recorder_get_instance_private(self);
+
+    g_return_val_if_fail(priv->client != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    result = seq_smf_recorder_operate_subscription(priv, FALSE, error);
+    if (result) {
+        result = seq_user_client_control_queue(priv->client, priv->queue_id,
+                                               SNDRV_SEQ_EVENT_STOP, error);
+    }
+
+    smf_put(priv, end_of_track, sizeof(end_of_track));
+    smf_flush(priv);
+
+    smf_put_be32(track_length, priv->total - SMF_TRACK_DATA_OFFSET);
+    if (priv->write_errno == 0 &&
+        pwrite(priv->fd, track_length, sizeof(track_length), SMF_TRACK_LENGTH_OFFSET) < 0)
+        priv->write_errno = errno;
+
+    if (priv->write_errno != 0 && result) {
+        generate_file_error(error, priv->write_errno, "write(%s)", "track");
+        result = FALSE;
+    }
+
+    seq_smf_recorder_release(priv);
+
+    return result;
+}
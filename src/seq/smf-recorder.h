@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_SMF_RECORDER_H__
+#define __ALSA_GOBJECT_ALSASEQ_SMF_RECORDER_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_SMF_RECORDER   (alsaseq_smf_recorder_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(ALSASeqSmfRecorder, alsaseq_smf_recorder, ALSASEQ, SMF_RECORDER, GObject);
+
+struct _ALSASeqSmfRecorderClass {
+    GObjectClass parent_class;
+};
+
+ALSASeqSmfRecorder *alsaseq_smf_recorder_new();
+
+gboolean alsaseq_smf_recorder_start(ALSASeqSmfRecorder *self, ALSASeqUserClient *client,
+                                    guint8 port_id, const ALSASeqAddr *sender, const gchar *path,
+                                    guint16 division, GError **error);
+
+gboolean alsaseq_smf_recorder_stop(ALSASeqSmfRecorder *self, GError **error);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,508 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+/**
+ * ALSASeqSysexTransfer:
+ * A GObject-derived object to transfer large system exclusive messages.
+ *
+ * A [class@SysexTransfer] is a GObject-derived object to transmit and receive system exclusive
+ * messages larger than the memory pool of client and the buffer to read events.
+ *
+ * For transmission, [method@SysexTransfer.send] splits the message into chunks of
+ * [property@SysexTransfer:chunk-size] and schedules as many chunks as
+ * [property@ClientPool:output-free] allows. The rest is scheduled by the source created by
+ * [method@SysexTransfer.create_pump_source] when the cells in memory pool become available, then
+ * [signal@SysexTransfer::sent] signal is emit. The chunks refer to the message in the given
+ * [struct@GLib.Bytes] till written.
+ *
+ * For reception, the fragments of message delivered to the port are accumulated in one buffer
+ * per source address from the leading `0xf0` to the trailing `0xf7`, then
+ * [signal@SysexTransfer::received] signal is emit with the buffer as [struct@GLib.Bytes] without
+ * copying it. The source of client should be attached to [struct@GLib.MainContext] to receive
+ * events.
+ */
+typedef struct {
+    struct snd_seq_addr destination;
+    GBytes *data;
+    gsize offset;
+} SysexJob;
+
+typedef struct {
+    ALSASeqUserClient *client;
+    guint8 port_id;
+    gulong handler_id;
+
+    guint chunk_size;
+    guint max_size;
+
+    GQueue jobs;
+    ALSASeqEventCntr *ev_cntr;
+    ALSASeqClientPool *pool;
+
+    GHashTable *fragments;
+} ALSASeqSysexTransferPrivate;
+G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqSysexTransfer, alsaseq_sysex_transfer, G_TYPE_OBJECT)
+
+// The size used by ALSA Sequencer core to split system exclusive message from rawmidi device.
+#define SYSEX_DEFAULT_CHUNK_SIZE    256
+#define SYSEX_DEFAULT_MAX_SIZE      (16 * 1024 * 1024)
+
+enum seq_sysex_transfer_prop_type {
+    SEQ_SYSEX_TRANSFER_PROP_CHUNK_SIZE = 1,
+    SEQ_SYSEX_TRANSFER_PROP_MAX_SIZE,
+    SEQ_SYSEX_TRANSFER_PROP_COUNT,
+};
+static GParamSpec *seq_sysex_transfer_props[SEQ_SYSEX_TRANSFER_PROP_COUNT] = { NULL, };
+
+enum seq_sysex_transfer_sig_type {
+    SEQ_SYSEX_TRANSFER_SIG_TYPE_RECEIVED = 0,
+    SEQ_SYSEX_TRANSFER_SIG_TYPE_SENT,
+    SEQ_SYSEX_TRANSFER_SIG_TYPE_COUNT,
+};
+static guint seq_sysex_transfer_sigs[SEQ_SYSEX_TRANSFER_SIG_TYPE_COUNT] = { 0 };
+
+static void seq_sysex_transfer_free_job(gpointer data)
+{
+    SysexJob *job = data;
+
+    g_bytes_unref(job->data);
+    g_free(job);
+}
+
+static void seq_sysex_transfer_set_property(GObject *obj, guint id, const GValue *val,
+                                            GParamSpec *spec)
+{
+    ALSASeqSysexTransfer *self = ALSASEQ_SYSEX_TRANSFER(obj);
+    ALSASeqSysexTransferPrivate *priv = alsaseq_sysex_transfer_get_instance_private(self);
+
+    switch (id) {
+    case SEQ_SYSEX_TRANSFER_PROP_CHUNK_SIZE:
+        priv->chunk_size = g_value_get_uint(val);
+        break;
+    case SEQ_SYSEX_TRANSFER_PROP_MAX_SIZE:
+        priv->max_size = g_value_get_uint(val);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void seq_sysex_transfer_get_property(GObject *obj, guint id, GValue *val,
+                                            GParamSpec *spec)
+{
+    ALSASeqSysexTransfer *self = ALSASEQ_SYSEX_TRANSFER(obj);
+    ALSASeqSysexTransferPrivate *priv = alsaseq_sysex_transfer_get_instance_private(self);
+
+    switch (id) {
+    case SEQ_SYSEX_TRANSFER_PROP_CHUNK_SIZE:
+        g_value_set_uint(val, priv->chunk_size);
+        break;
+    case SEQ_SYSEX_TRANSFER_PROP_MAX_SIZE:
+        g_value_set_uint(val, priv->max_size);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void seq_sysex_transfer_finalize(GObject *obj)
+{
+    ALSASeqSysexTransfer *self = ALSASEQ_SYSEX_TRANSFER(obj);
+    ALSASeqSysexTransferPrivate *priv = alsaseq_sysex_transfer_get_instance_private(self);
+
+    alsaseq_sysex_transfer_stop(self);
+
+    g_hash_table_unref(priv->fragments);
+    g_boxed_free(ALSASEQ_TYPE_EVENT_CNTR, priv->ev_cntr);
+    g_object_unref(priv->pool);
+
+    G_OBJECT_CLASS(alsaseq_sysex_transfer_parent_class)->finalize(obj);
+}
+
+static void alsaseq_sysex_transfer_class_init(ALSASeqSysexTransferClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = seq_sysex_transfer_finalize;
+    gobject_class->set_property = seq_sysex_transfer_set_property;
+    gobject_class->get_property = seq_sysex_transfer_get_property;
+
+    /**
+     * ALSASeqSysexTransfer:chunk-size:
+     *
+     * The maximum size of blob data in each event for transmission.
+     */
+    seq_sysex_transfer_props[SEQ_SYSEX_TRANSFER_PROP_CHUNK_SIZE] =
+        g_param_spec_uint("chunk-size", "chunk-size",
+                          "The maximum size of blob data in each event for transmission.",
+                          1, G_MAXINT,
+                          SYSEX_DEFAULT_CHUNK_SIZE,
+                          G_PARAM_READWRITE);
+
+    /**
+     * ALSASeqSysexTransfer:max-size:
+     *
+     * The maximum size of message for reception. The message larger than it is discarded.
+     */
+    seq_sysex_transfer_props[SEQ_SYSEX_TRANSFER_PROP_MAX_SIZE] =
+        g_param_spec_uint("max-size", "max-size",
+                          "The maximum size of message for reception.",
+                          1, G_MAXUINT,
+                          SYSEX_DEFAULT_MAX_SIZE,
+                          G_PARAM_READWRITE);
+
+    g_object_class_install_properties(gobject_class, SEQ_SYSEX_TRANSFER_PROP_COUNT,
+                                      seq_sysex_transfer_props);
+
+    /**
+     * ALSASeqSysexTransfer::received:
+     * @self: A [class@SysexTransfer].
+     * @source: The address of source.
+     * @data: The reassembled system exclusive message from the leading `0xf0` to the trailing
+     *        `0xf7`.
+     *
+     * When the trailing fragment of system exclusive message is received, this signal is emit.
+     */
+    seq_sysex_transfer_sigs[SEQ_SYSEX_TRANSFER_SIG_TYPE_RECEIVED] =
+        g_signal_new("received",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqSysexTransferClass, received),
+                     NULL, NULL,
+                     g_cclosure_marshal_generic,
+                     G_TYPE_NONE, 2, ALSASEQ_TYPE_ADDR, G_TYPE_BYTES);
+
+    /**
+     * ALSASeqSysexTransfer::sent:
+     * @self: A [class@SysexTransfer].
+     * @destination: The address of destination.
+     * @error: (nullable): A [struct@GLib.Error] when the transmission is aborted, else %NULL.
+     *
+     * When all of chunks of the message are written, or the transmission is aborted by the source
+     * created by [method@SysexTransfer.create_pump_source], this signal is emit.
+     */
+    seq_sysex_transfer_sigs[SEQ_SYSEX_TRANSFER_SIG_TYPE_SENT] =
+        g_signal_new("sent",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqSysexTransferClass, sent),
+                     NULL, NULL,
+                     g_cclosure_marshal_generic,
+                     G_TYPE_NONE, 2, ALSASEQ_TYPE_ADDR, G_TYPE_ERROR);
+}
+
+static void alsaseq_sysex_transfer_init(ALSASeqSysexTransfer *self)
+{
+    ALSASeqSysexTransferPrivate *priv = alsaseq_sysex_transfer_get_instance_private(self);
+
+    priv->chunk_size = SYSEX_DEFAULT_CHUNK_SIZE;
+    priv->max_size = SYSEX_DEFAULT_MAX_SIZE;
+
+    g_queue_init(&priv->jobs);
+    priv->ev_cntr = alsaseq_event_cntr_new(0);
+    priv->pool = alsaseq_client_pool_new();
+    priv->fragments = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                                            (GDestroyNotify)g_byte_array_unref);
+}
+
+/**
+ * alsaseq_sysex_transfer_new:
+ *
+ * Allocate and return an instance of [class@SysexTransfer].
+ *
+ * Returns: An instance of [class@SysexTransfer].
+ */
+ALSASeqSysexTransfer *alsaseq_sysex_transfer_new()
+{
+    return g_object_new(ALSASEQ_TYPE_SYSEX_TRANSFER, NULL);
+}
+
+static void seq_sysex_transfer_emit_sent(ALSASeqSysexTransfer *self, SysexJob *job,
+                                         const GError *error)
+{
+    g_signal_emit(self, seq_sysex_transfer_sigs[SEQ_SYSEX_TRANSFER_SIG_TYPE_SENT], 0,
+                  &job->destination, error);
+    seq_sysex_transfer_free_job(job);
+}
+
+// Schedule the chunks as many as the memory pool allows.
+static gboolean seq_sysex_transfer_pump(ALSASeqSysexTransfer *self, GError **error)
+{
+    ALSASeqSysexTransferPrivate *priv = alsaseq_sysex_transfer_get_instance_private(self);
+    guint output_free;
+
+    if (g_queue_is_empty(&priv->jobs))
+        return TRUE;
+
+    if (!alsaseq_user_client_get_pool(priv->client, &priv->pool, error))
+        return FALSE;
+    g_object_get(priv->pool, "output-free", &output_free, NULL);
+
+    // The handler of signal can stop the transfer.
+    while (priv->client != NULL && !g_queue_is_empty(&priv->jobs)) {
+        SysexJob *job = g_queue_peek_head(&priv->jobs);
+        struct snd_seq_event ev = { 0 };
+        const guint8 *data;
+        gsize size;
+        gsize offset;
+        gsize count;
+
+        data = g_bytes_get_data(job->data, &size);
+
+        ev.type = SNDRV_SEQ_EVENT_SYSEX;
+        ev.flags = SNDRV_SEQ_EVENT_LENGTH_VARIABLE;
+        ev.queue = SNDRV_SEQ_QUEUE_DIRECT;
+        ev.source.port = priv->port_id;
+        ev.dest = job->destination;
+
+        alsaseq_event_cntr_clear(priv->ev_cntr);
+        offset = job->offset;
+        while (offset < size) {
+            gsize length = MIN(size - offset, priv->chunk_size);
+            guint cells;
+
+            ev.data.ext.len = length;
+            ev.data.ext.ptr = (void *)(data + offset);
+
+            alsaseq_event_calculate_pool_consumption(&ev, &cells);
+            if (cells > output_free)
+                break;
+
+            if (!alsaseq_event_cntr_append_event(priv->ev_cntr, &ev, error))
+                return FALSE;
+
+            output_free -= cells;
+            offset += length;
+        }
+
+        // Wait for the cells to be available.
+        if (offset == job->offset)
+            break;
+
+        if (!alsaseq_user_client_schedule_event_cntr(priv->client, priv->ev_cntr, &count, error))
+            return FALSE;
+
+        job->offset = MIN(job->offset + count * priv->chunk_size, size);
+        if (job->offset < size)
+            break;
+
+        g_queue_pop_head(&priv->jobs);
+        seq_sysex_transfer_emit_sent(self, job, NULL);
+    }
+
+    return TRUE;
+}
+
+static void seq_sysex_transfer_handle_event(ALSASeqUserClient *client,
+                                            const ALSASeqEventCntr *ev_cntr, gpointer user_data)
+{
+    ALSASeqSysexTransfer *self = ALSASEQ_SYSEX_TRANSFER(user_data);
+    ALSASeqSysexTransferPrivate *priv = alsaseq_sysex_transfer_get_instance_private(self);
+    gsize pos = 0;
+
+    while (pos + sizeof(struct snd_seq_event) <= ev_cntr->length) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)(ev_cntr->buf + pos);
+        // NOTE: the event is followed by the blob in the flattened layout.
+        const guint8 *blob = (const guint8 *)(ev + 1);
+        gsize length = ev->data.ext.len;
+        gpointer key;
+        GByteArray *frags;
+
+        pos += seq_event_calculate_flattened_length(ev, ev_cntr->aligned);
+
+        if (ev->type != SNDRV_SEQ_EVENT_SYSEX || ev->dest.port != priv->port_id ||
+            (ev->flags & SNDRV_SEQ_EVENT_LENGTH_MASK) != SNDRV_SEQ_EVENT_LENGTH_VARIABLE ||
+            length == 0)
+            continue;
+
+        key = GUINT_TO_POINTER((ev->source.client << 8) | ev->source.port);
+
+        if (blob[0] == 0xf0) {
+            // The former message is discarded when it is not terminated.
+            frags = g_byte_array_sized_new(MAX(length, priv->chunk_size));
+            g_hash_table_replace(priv->fragments, key, frags);
+        } else {
+            frags = g_hash_table_lookup(priv->fragments, key);
+            if (frags == NULL)
+                continue;
+        }
+
+        if (frags->len + length > priv->max_size) {
+            g_hash_table_remove(priv->fragments, key);
+            continue;
+        }
+        g_byte_array_append(frags, blob, length);
+
+        if (blob[length - 1] == 0xf7) {
+            GBytes *data;
+
+            g_hash_table_steal(priv->fragments, key);
+            data = g_byte_array_free_to_bytes(frags);
+
+            g_signal_emit(self, seq_sysex_transfer_sigs[SEQ_SYSEX_TRANSFER_SIG_TYPE_RECEIVED], 0,
+                          &ev->source, data);
+            g_bytes_unref(data);
+        }
+    }
+}
+
+/**
+ * alsaseq_sysex_transfer_start:
+ * @self: A [class@SysexTransfer].
+ * @client: A [class@UserClient] to transmit and receive messages.
+ * @port_id: The numeric ID of port in the client as source of transmission and destination of
+ *           reception.
+ * @error: A [struct@GLib.Error].
+ *
+ * Start to receive messages delivered to the port, and enable transmission from the port.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_sysex_transfer_start(ALSASeqSysexTransfer *self, ALSASeqUserClient *client,
+                                      guint8 port_id, GError **error)
+{
+    ALSASeqSysexTransferPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_SYSEX_TRANSFER(self), FALSE);
+    priv = alsaseq_sysex_transfer_get_instance_private(self);
+
+    g_return_val_if_fail(priv->client == NULL, FALSE);
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(client), FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv->client = g_object_ref(client);
+    priv->port_id = port_id;
+
+    // The transfer can be finalized before the client.
+    priv->handler_id = g_signal_connect_object(client, "handle-event",
+                                               (GCallback)seq_sysex_transfer_handle_event, self,
+                                               0);
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_sysex_transfer_stop:
+ * @self: A [class@SysexTransfer].
+ *
+ * Stop reception and transmission. The messages pending for transmission and the fragments of
+ * messages under reception are discarded.
+ */
+void alsaseq_sysex_transfer_stop(ALSASeqSysexTransfer *self)
+{
+    ALSASeqSysexTransferPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_SYSEX_TRANSFER(self));
+    priv = alsaseq_sysex_transfer_get_instance_private(self);
+
+    if (priv->client != NULL) {
+        g_signal_handler_disconnect(priv->client, priv->handler_id);
+        g_object_unref(priv->client);
+    }
+    priv->client = NULL;
+    priv->handler_id = 0;
+
+    g_queue_clear_full(&priv->jobs, seq_sysex_transfer_free_job);
+    g_hash_table_remove_all(priv->fragments);
+}
+
+/**
+ * alsaseq_sysex_transfer_send:
+ * @self: A [class@SysexTransfer].
+ * @destination: The address of destination.
+ * @data: The system exclusive message.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Queue the message for transmission, then schedule the chunks of message as many as
+ * [property@ClientPool:output-free] allows when no message is pending. The message is kept by
+ * reference count till all of chunks are written. When all of chunks are written,
+ * [signal@SysexTransfer::sent] signal is emit.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_sysex_transfer_send(ALSASeqSysexTransfer *self, const ALSASeqAddr *destination,
+                                     GBytes *data, GError **error)
+{
+    ALSASeqSysexTransferPrivate *priv;
+    SysexJob *job;
+
+    g_return_val_if_fail(ALSASEQ_IS_SYSEX_TRANSFER(self), FALSE);
+    priv = alsaseq_sysex_transfer_get_instance_private(self);
+
+    g_return_val_if_fail(priv->client != NULL, FALSE);
+    g_return_val_if_fail(destination != NULL, FALSE);
+    g_return_val_if_fail(data != NULL && g_bytes_get_size(data) > 0, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    job = g_new0(SysexJob, 1);
+    job->destination = *destination;
+    job->data = g_bytes_ref(data);
+    g_queue_push_tail(&priv->jobs, job);
+
+    // The former messages are pumped by the source.
+    if (g_queue_get_length(&priv->jobs) > 1)
+        return TRUE;
+
+    if (!seq_sysex_transfer_pump(self, error)) {
+        // The message is not queued when failed.
+        if (g_queue_peek_tail(&priv->jobs) == job) {
+            g_queue_pop_tail(&priv->jobs);
+            seq_sysex_transfer_free_job(job);
+        }
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean seq_sysex_transfer_pump_src(gpointer user_data)
+{
+    ALSASeqSysexTransfer *self = ALSASEQ_SYSEX_TRANSFER(user_data);
+    ALSASeqSysexTransferPrivate *priv = alsaseq_sysex_transfer_get_instance_private(self);
+    GError *error = NULL;
+
+    if (priv->client == NULL)
+        return G_SOURCE_CONTINUE;
+
+    if (!seq_sysex_transfer_pump(self, &error)) {
+        // The message at head is aborted so that the others are not blocked.
+        SysexJob *job = g_queue_pop_head(&priv->jobs);
+
+        if (job != NULL)
+            seq_sysex_transfer_emit_sent(self, job, error);
+        g_error_free(error);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * alsaseq_sysex_transfer_create_pump_source:
+ * @self: A [class@SysexTransfer].
+ * @interval: The interval to check memory pool in millisecond unit.
+ * @gsrc: (out): A [struct@GLib.Source] to schedule the pending chunks.
+ * @error: A [struct@GLib.Error].
+ *
+ * Allocate [struct@GLib.Source] structure to schedule the chunks of pending messages at the
+ * interval as many as [property@ClientPool:output-free] allows. When any error occurs, the
+ * message at head is aborted and [signal@SysexTransfer::sent] signal is emit with the error.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_sysex_transfer_create_pump_source(ALSASeqSysexTransfer *self, guint interval,
+                                                   GSource **gsrc, GError **error)
+{
+    g_return_val_if_fail(ALSASEQ_IS_SYSEX_TRANSFER(self), FALSE);
+    g_return_val_if_fail(interval > 0, FALSE);
+    g_return_val_if_fail(gsrc != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    *gsrc = g_timeout_source_new(interval);
+    g_source_set_name(*gsrc, "ALSASeqSysexTransferPump");
+    g_source_set_callback(*gsrc, seq_sysex_transfer_pump_src, g_object_ref(self), g_object_unref);
+
+    return TRUE;
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_SYSEX_TRANSFER_H__
+#define __ALSA_GOBJECT_ALSASEQ_SYSEX_TRANSFER_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_SYSEX_TRANSFER (alsaseq_sysex_transfer_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(ALSASeqSysexTransfer, alsaseq_sysex_transfer, ALSASEQ, SYSEX_TRANSFER,
+                         GObject);
+
+struct _ALSASeqSysexTransferClass {
+    GObjectClass parent_class;
+
+    /**
+     * ALSASeqSysexTransferClass::received:
+     * @self: A [class@SysexTransfer].
+     * @source: The address of source.
+     * @data: The reassembled system exclusive message.
+     *
+     * Class closure for the [signal@SysexTransfer::received] signal.
+     */
+    void (*received)(ALSASeqSysexTransfer *self, const ALSASeqAddr *source, GBytes *data);
+
+    /**
+     * ALSASeqSysexTransferClass::sent:
+     * @self: A [class@SysexTransfer].
+     * @destination: The address of destination.
+     * @error: (nullable): A [struct@GLib.Error] when the transmission is aborted, else %NULL.
+     *
+     * Class closure for the [signal@SysexTransfer::sent] signal.
+     */
+    void (*sent)(ALSASeqSysexTransfer *self, const ALSASeqAddr *destination,
+                 const GError *error);
+};
+
+ALSASeqSysexTransfer *alsaseq_sysex_transfer_new();
+
+gboolean alsaseq_sysex_transfer_start(ALSASeqSysexTransfer *self, ALSASeqUserClient *client,
+                                      guint8 port_id, GError **error);
+
+void alsaseq_sysex_transfer_stop(ALSASeqSysexTransfer *self);
+
+gboolean alsaseq_sysex_transfer_send(ALSASeqSysexTransfer *self, const ALSASeqAddr *destination,
+                                     GBytes *data, GError **error);
+
+gboolean alsaseq_sysex_transfer_create_pump_source(ALSASeqSysexTransfer *self, guint interval,
+                                                   GSource **gsrc, GError **error);
+
+G_END_DECLS
+
+#endif
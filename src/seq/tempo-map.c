@@ -0,0 +1,493 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+/**
+ * ALSASeqTempoMap:
+ * A GObject-derived object to convert time stamp between tick and real time.
+ *
+ * A [class@TempoMap] is a GObject-derived object to record the changes of tempo in queue and
+ * convert time stamp between tick and real time across the changes. The map consists of segments
+ * each of which starts at the tick of tempo change, and the real time at the start of segment is
+ * cached so that the conversion is done by binary search for the segment. The cache is updated
+ * lazily for the segments after the change when the tempo is added.
+ *
+ * The skew of queue is not taken into account; i.e. [property@QueueTempo:skew] is assumed to
+ * be nominal.
+ */
+typedef struct {
+    guint tick;
+    guint tempo;
+    guint64 time;
+} TempoSegment;
+
+typedef struct {
+    GArray *segments;
+    // The number of segments in which the time at start is valid.
+    guint valid;
+    guint resolution;
+} ALSASeqTempoMapPrivate;
+G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqTempoMap, alsaseq_tempo_map, G_TYPE_OBJECT)
+
+// The default parameters of queue in ALSA Sequencer core.
+#define TEMPO_MAP_DEFAULT_RESOLUTION    96
+
+enum seq_tempo_map_prop_type {
+    SEQ_TEMPO_MAP_PROP_RESOLUTION = 1,
+    SEQ_TEMPO_MAP_PROP_SEGMENT_COUNT,
+    SEQ_TEMPO_MAP_PROP_COUNT,
+};
+static GParamSpec *seq_tempo_map_props[SEQ_TEMPO_MAP_PROP_COUNT] = { NULL, };
+
+static void seq_tempo_map_set_property(GObject *obj, guint id, const GValue *val,
+                                       GParamSpec *spec)
+{
+    ALSASeqTempoMap *self = ALSASEQ_TEMPO_MAP(obj);
+    ALSASeqTempoMapPrivate *priv = alsaseq_tempo_map_get_instance_private(self);
+
+    switch (id) {
+    case SEQ_TEMPO_MAP_PROP_RESOLUTION:
+        priv->resolution = g_value_get_uint(val);
+        // The time at start of segment depends on the resolution.
+        priv->valid = 1;
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void seq_tempo_map_get_property(GObject *obj, guint id, GValue *val, GParamSpec *spec)
+{
+    ALSASeqTempoMap *self = ALSASEQ_TEMPO_MAP(obj);
+    ALSASeqTempoMapPrivate *priv = alsaseq_tempo_map_get_instance_private(self);
+
+    switch (id) {
+    case SEQ_TEMPO_MAP_PROP_RESOLUTION:
+        g_value_set_uint(val, priv->resolution);
+        break;
+    case SEQ_TEMPO_MAP_PROP_SEGMENT_COUNT:
+        g_value_set_uint(val, priv->segments->len);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void seq_tempo_map_finalize(GObject *obj)
+{
+    ALSASeqTempoMap *self = ALSASEQ_TEMPO_MAP(obj);
+    ALSASeqTempoMapPrivate *priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_array_unref(priv->segments);
+
+    G_OBJECT_CLASS(alsaseq_tempo_map_parent_class)->finalize(obj);
+}
+
+static void alsaseq_tempo_map_class_init(ALSASeqTempoMapClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = seq_tempo_map_finalize;
+    gobject_class->set_property = seq_tempo_map_set_property;
+    gobject_class->get_property = seq_tempo_map_get_property;
+
+    /**
+     * ALSASeqTempoMap:resolution:
+     *
+     * The number of ticks per quarter note. The maximum is the same as the division of SMF.
+     */
+    seq_tempo_map_props[SEQ_TEMPO_MAP_PROP_RESOLUTION] =
+        g_param_spec_uint("resolution", "resolution",
+                          "The number of ticks per quarter note.",
+                          1, G_MAXUINT16,
+                          TEMPO_MAP_DEFAULT_RESOLUTION,
+                          G_PARAM_READWRITE);
+
+    /**
+     * ALSASeqTempoMap:segment-count:
+     *
+     * The number of segments with constant tempo.
+     */
+    seq_tempo_map_props[SEQ_TEMPO_MAP_PROP_SEGMENT_COUNT] =
+        g_param_spec_uint("segment-count", "segment-count",
+                          "The number of segments with constant tempo.",
+                          1, G_MAXUINT,
+                          1,
+                          G_PARAM_READABLE);
+
+    g_object_class_install_properties(gobject_class, SEQ_TEMPO_MAP_PROP_COUNT,
+                                      seq_tempo_map_props);
+}
+
+static void seq_tempo_map_reset(ALSASeqTempoMapPrivate *priv)
+{
+    TempoSegment seg = { .tick = 0, .tempo = SMF_DEFAULT_TEMPO, .time = 0, };
+
+    g_array_set_size(priv->segments, 0);
+    g_array_append_val(priv->segments, seg);
+    priv->valid = 1;
+}
+
+static void alsaseq_tempo_map_init(ALSASeqTempoMap *self)
+{
+    ALSASeqTempoMapPrivate *priv = alsaseq_tempo_map_get_instance_private(self);
+
+    priv->segments = g_array_new(FALSE, FALSE, sizeof(TempoSegment));
+    priv->resolution = TEMPO_MAP_DEFAULT_RESOLUTION;
+    seq_tempo_map_reset(priv);
+}
+
+/**
+ * alsaseq_tempo_map_new:
+ *
+ * Allocate and return an instance of [class@TempoMap]. The map has a segment with the default
+ * tempo of queue (500000 micro seconds per quarter note) at the beginning.
+ *
+ * Returns: An instance of [class@TempoMap].
+ */
+ALSASeqTempoMap *alsaseq_tempo_map_new()
+{
+    return g_object_new(ALSASEQ_TYPE_TEMPO_MAP, NULL);
+}
+
+// The computation is split by the quotient so that the intermediate value is not overflown. The
+// product of remainder fits in 64 bits since the resolution is up to 16 bits and the tempo is up to
+// 32 bits.
+static guint64 seq_tempo_map_ticks_to_nsec(guint64 ticks, guint tempo, guint resolution)
+{
+    guint64 nsec_per_quarter = (guint64)tempo * 1000;
+
+    return ticks / resolution * nsec_per_quarter +
+           ticks % resolution * nsec_per_quarter / resolution;
+}
+
+static guint64 seq_tempo_map_nsec_to_ticks(guint64 nsec, guint tempo, guint resolution)
+{
+    guint64 nsec_per_quarter = (guint64)tempo * 1000;
+
+    return nsec / nsec_per_quarter * resolution +
+           nsec % nsec_per_quarter * resolution / nsec_per_quarter;
+}
+
+static void seq_tempo_map_update(ALSASeqTempoMapPrivate *priv)
+{
+    TempoSegment *segs = (TempoSegment *)priv->segments->data;
+    guint i;
+
+    for (i = priv->valid; i < priv->segments->len; ++i) {
+        const TempoSegment *prev = segs + i - 1;
+
+        segs[i].time = prev->time + seq_tempo_map_ticks_to_nsec(segs[i].tick - prev->tick,
+                                                                prev->tempo, priv->resolution);
+    }
+    priv->valid = priv->segments->len;
+}
+
+// Return the index of the last segment starting at or before the tick.
+static guint seq_tempo_map_find_by_tick(const ALSASeqTempoMapPrivate *priv, guint tick)
+{
+    const TempoSegment *segs = (const TempoSegment *)priv->segments->data;
+    guint lower = 0;
+    guint upper = priv->segments->len;
+
+    while (upper - lower > 1) {
+        guint middle = lower + (upper - lower) / 2;
+
+        if (segs[middle].tick <= tick)
+            lower = middle;
+        else
+            upper = middle;
+    }
+
+    return lower;
+}
+
+// Return the index of the last segment starting at or before the time.
+static guint seq_tempo_map_find_by_time(const ALSASeqTempoMapPrivate *priv, guint64 time)
+{
+    const TempoSegment *segs = (const TempoSegment *)priv->segments->data;
+    guint lower = 0;
+    guint upper = priv->segments->len;
+
+    while (upper - lower > 1) {
+        guint middle = lower + (upper - lower) / 2;
+
+        if (segs[middle].time <= time)
+            lower = middle;
+        else
+            upper = middle;
+    }
+
+    return lower;
+}
+
+/**
+ * alsaseq_tempo_map_add_tempo:
+ * @self: A [class@TempoMap].
+ * @tick: The tick at which the tempo is changed.
+ * @tempo: The number of micro seconds per quarter note.
+ *
+ * Add the change of tempo at the tick. The tempo at the same tick is replaced.
+ */
+void alsaseq_tempo_map_add_tempo(ALSASeqTempoMap *self, guint tick, guint tempo)
+{
+    ALSASeqTempoMapPrivate *priv;
+    TempoSegment *segs;
+    guint index;
+
+    g_return_if_fail(ALSASEQ_IS_TEMPO_MAP(self));
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_return_if_fail(tempo > 0);
+
+    index = seq_tempo_map_find_by_tick(priv, tick);
+    segs = (TempoSegment *)priv->segments->data;
+
+    // The time at start of segments after the change is computed again at next conversion.
+    if (segs[index].tick == tick) {
+        segs[index].tempo = tempo;
+        priv->valid = MIN(priv->valid, index + 1);
+    } else {
+        TempoSegment seg = { .tick = tick, .tempo = tempo, .time = 0, };
+
+        ++index;
+        g_array_insert_val(priv->segments, index, seg);
+        priv->valid = MIN(priv->valid, index);
+    }
+}
+
+/**
+ * alsaseq_tempo_map_clear:
+ * @self: A [class@TempoMap].
+ *
+ * Remove all of changes of tempo, then add the default tempo at the beginning.
+ */
+void alsaseq_tempo_map_clear(ALSASeqTempoMap *self)
+{
+    ALSASeqTempoMapPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_TEMPO_MAP(self));
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    seq_tempo_map_reset(priv);
+}
+
+/**
+ * alsaseq_tempo_map_get_tempo:
+ * @self: A [class@TempoMap].
+ * @tick: The tick.
+ * @tempo: (out): The number of micro seconds per quarter note at the tick.
+ *
+ * Get the tempo at the tick.
+ */
+void alsaseq_tempo_map_get_tempo(ALSASeqTempoMap *self, guint tick, guint *tempo)
+{
+    ALSASeqTempoMapPrivate *priv;
+    guint index;
+
+    g_return_if_fail(ALSASEQ_IS_TEMPO_MAP(self));
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_return_if_fail(tempo != NULL);
+
+    index = seq_tempo_map_find_by_tick(priv, tick);
+    *tempo = g_array_index(priv->segments, TempoSegment, index).tempo;
+}
+
+static guint64 seq_tempo_map_segment_tick_to_time(const ALSASeqTempoMapPrivate *priv,
+                                                  const TempoSegment *seg, guint tick)
+{
+    return seg->time + seq_tempo_map_ticks_to_nsec(tick - seg->tick, seg->tempo, priv->resolution);
+}
+
+static guint seq_tempo_map_segment_time_to_tick(const ALSASeqTempoMapPrivate *priv,
+                                                const TempoSegment *seg, guint64 time)
+{
+    guint64 tick = seg->tick +
+                   seq_tempo_map_nsec_to_ticks(time - seg->time, seg->tempo, priv->resolution);
+
+    return (guint)MIN(tick, G_MAXUINT);
+}
+
+/**
+ * alsaseq_tempo_map_tick_to_time:
+ * @self: A [class@TempoMap].
+ * @tick: The tick.
+ * @time: (out): The real time in nanosecond unit.
+ *
+ * Convert the tick to the real time since the beginning of queue.
+ */
+void alsaseq_tempo_map_tick_to_time(ALSASeqTempoMap *self, guint tick, guint64 *time)
+{
+    ALSASeqTempoMapPrivate *priv;
+    guint index;
+
+    g_return_if_fail(ALSASEQ_IS_TEMPO_MAP(self));
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_return_if_fail(time != NULL);
+
+    seq_tempo_map_update(priv);
+
+    index = seq_tempo_map_find_by_tick(priv, tick);
+    *time = seq_tempo_map_segment_tick_to_time(priv,
+                                               &g_array_index(priv->segments, TempoSegment, index),
+                                               tick);
+}
+
+/**
+ * alsaseq_tempo_map_time_to_tick:
+ * @self: A [class@TempoMap].
+ * @time: The real time in nanosecond unit.
+ * @tick: (out): The tick.
+ *
+ * Convert the real time since the beginning of queue to the tick. The fraction of tick is
+ * truncated, and the tick is saturated at the maximum value.
+ */
+void alsaseq_tempo_map_time_to_tick(ALSASeqTempoMap *self, guint64 time, guint *tick)
+{
+    ALSASeqTempoMapPrivate *priv;
+    guint index;
+
+    g_return_if_fail(ALSASEQ_IS_TEMPO_MAP(self));
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_return_if_fail(tick != NULL);
+
+    seq_tempo_map_update(priv);
+
+    index = seq_tempo_map_find_by_time(priv, time);
+    *tick = seq_tempo_map_segment_time_to_tick(priv,
+                                               &g_array_index(priv->segments, TempoSegment, index),
+                                               time);
+}
+
+/**
+ * alsaseq_tempo_map_ticks_to_times:
+ * @self: A [class@TempoMap].
+ * @ticks: (array length=count): The array of ticks.
+ * @count: The number of elements in the arrays.
+ * @times: (array length=count)(out caller-allocates): The array to store the real time in
+ *         nanosecond unit.
+ *
+ * Convert the array of ticks to the array of real time. The segment for the previous element is
+ * examined at first, thus the conversion is efficient for the array in ascending order.
+ */
+void alsaseq_tempo_map_ticks_to_times(ALSASeqTempoMap *self, const guint *ticks, gsize count,
+                                      guint64 *times)
+{
+    ALSASeqTempoMapPrivate *priv;
+    const TempoSegment *segs;
+    guint index;
+    gsize i;
+
+    g_return_if_fail(ALSASEQ_IS_TEMPO_MAP(self));
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_return_if_fail(ticks != NULL || count == 0);
+    g_return_if_fail(times != NULL || count == 0);
+
+    seq_tempo_map_update(priv);
+    segs = (const TempoSegment *)priv->segments->data;
+
+    index = 0;
+    for (i = 0; i < count; ++i) {
+        guint tick = ticks[i];
+
+        if (tick < segs[index].tick ||
+            (index + 1 < priv->segments->len && tick >= segs[index + 1].tick))
+            index = seq_tempo_map_find_by_tick(priv, tick);
+
+        times[i] = seq_tempo_map_segment_tick_to_time(priv, segs + index, tick);
+    }
+}
+
+/**
+ * alsaseq_tempo_map_times_to_ticks:
+ * @self: A [class@TempoMap].
+ * @times: (array length=count): The array of real time in nanosecond unit.
+ * @count: The number of elements in the arrays.
+ * @ticks: (array length=count)(out caller-allocates): The array to store the ticks.
+ *
+ * Convert the array of real time to the array of ticks. The segment for the previous element is
+ * examined at first, thus the conversion is efficient for the array in ascending order.
+ */
+void alsaseq_tempo_map_times_to_ticks(ALSASeqTempoMap *self, const guint64 *times, gsize count,
+                                      guint *ticks)
+{
+    ALSASeqTempoMapPrivate *priv;
+    const TempoSegment *segs;
+    guint index;
+    gsize i;
+
+    g_return_if_fail(ALSASEQ_IS_TEMPO_MAP(self));
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_return_if_fail(times != NULL || count == 0);
+    g_return_if_fail(ticks != NULL || count == 0);
+
+    seq_tempo_map_update(priv);
+    segs = (const TempoSegment *)priv->segments->data;
+
+    index = 0;
+    for (i = 0; i < count; ++i) {
+        guint64 time = times[i];
+
+        if (time < segs[index].time ||
+            (index + 1 < priv->segments->len && time >= segs[index + 1].time))
+            index = seq_tempo_map_find_by_time(priv, time);
+
+        ticks[i] = seq_tempo_map_segment_time_to_tick(priv, segs + index, time);
+    }
+}
+
+/**
+ * alsaseq_tempo_map_append_tempo_events:
+ * @self: A [class@TempoMap].
+ * @port_id: The numeric ID of port as source of events.
+ * @queue_id: The numeric ID of queue.
+ * @ev_cntr: A [struct@EventCntr] to which the events are appended.
+ * @error: A [struct@GLib.Error].
+ *
+ * Append the events of [enum@EventType].TEMPO for each segment to the container. The events are
+ * scheduled in tick of the queue and delivered to the system timer, thus the scheduling of
+ * container by [method@UserClient.schedule_event_cntr] reproduces the map in the queue. The
+ * resolution of queue should be the same as [property@TempoMap:resolution].
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_tempo_map_append_tempo_events(ALSASeqTempoMap *self, guint8 port_id,
+                                               guint8 queue_id, ALSASeqEventCntr *ev_cntr,
+                                               GError **error)
+{
+    ALSASeqTempoMapPrivate *priv;
+    struct snd_seq_event ev = { 0 };
+    guint i;
+
+    g_return_val_if_fail(ALSASEQ_IS_TEMPO_MAP(self), FALSE);
+    priv = alsaseq_tempo_map_get_instance_private(self);
+
+    g_return_val_if_fail(ev_cntr != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    ev.type = SNDRV_SEQ_EVENT_TEMPO;
+    ev.flags = SNDRV_SEQ_TIME_STAMP_TICK | SNDRV_SEQ_TIME_MODE_ABS | SNDRV_SEQ_EVENT_LENGTH_FIXED;
+    ev.queue = queue_id;
+    ev.source.port = port_id;
+    ev.dest.client = SNDRV_SEQ_CLIENT_SYSTEM;
+    ev.dest.port = SNDRV_SEQ_PORT_SYSTEM_TIMER;
+    ev.data.queue.queue = queue_id;
+
+    for (i = 0; i < priv->segments->len; ++i) {
+        const TempoSegment *seg = &g_array_index(priv->segments, TempoSegment, i);
+
+        ev.time.tick = seg->tick;
+        ev.data.queue.param.value = seg->tempo;
+
+        if (!alsaseq_event_cntr_append_event(ev_cntr, &ev, error))
+            return FALSE;
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_TEMPO_MAP_H__
+#define __ALSA_GOBJECT_ALSASEQ_TEMPO_MAP_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_TEMPO_MAP      (alsaseq_tempo_map_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(ALSASeqTempoMap, alsaseq_tempo_map, ALSASEQ, TEMPO_MAP, GObject);
+
+struct _ALSASeqTempoMapClass {
+    GObjectClass parent_class;
+};
+
+ALSASeqTempoMap *alsaseq_tempo_map_new();
+
+void alsaseq_tempo_map_add_tempo(ALSASeqTempoMap *self, guint tick, guint tempo);
+
+void alsaseq_tempo_map_clear(ALSASeqTempoMap *self);
+
+void alsaseq_tempo_map_get_tempo(ALSASeqTempoMap *self, guint tick, guint *tempo);
+
+void alsaseq_tempo_map_tick_to_time(ALSASeqTempoMap *self, guint tick, guint64 *time);
+
+void alsaseq_tempo_map_time_to_tick(ALSASeqTempoMap *self, guint64 time, guint *tick);
+
+void alsaseq_tempo_map_ticks_to_times(ALSASeqTempoMap *self, const guint *ticks, gsize count,
+                                      guint64 *times);
+
+void alsaseq_tempo_map_times_to_ticks(ALSASeqTempoMap *self, const guint64 *times, gsize count,
+                                      guint *ticks);
+
+gboolean alsaseq_tempo_map_append_tempo_events(ALSASeqTempoMap *self, guint8 port_id,
+                                               guint8 queue_id, ALSASeqEventCntr *ev_cntr,
+                                               GError **error);
+
+G_END_DECLS
+
+#endif
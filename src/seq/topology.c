@@ -0,0 +1,773 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <errno.h>
+
+/**
+ * ALSASeqTopology:
+ * A GObject-derived object to maintain snapshot of clients, ports, and subscriptions.
+ *
+ * A [class@Topology] is a GObject-derived object to maintain snapshot of the graph of clients,
+ * ports, and subscriptions in ALSA sequencer. The call of [method@Topology.open] builds the
+ * snapshot at once, then subscribes the port of system announce to keep the snapshot up to date.
+ * Once the source returned by [method@Topology.create_source] is attached to
+ * [struct@GLib.MainContext], the announcements such as `CLIENT_START`, `PORT_CHANGE`, and
+ * `PORT_SUBSCRIBED` are applied to the snapshot as delta, and signals are emitted for the delta.
+ * The lookup of snapshot requires no system call.
+ *
+ * The client and port used to receive the announcements are not included in the snapshot.
+ */
+typedef struct {
+    ALSASeqUserClient *client;
+    guint8 client_id;
+    GHashTable *clients;
+    GHashTable *ports;
+    GHashTable *subscriptions;
+} ALSASeqTopologyPrivate;
+G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqTopology, alsaseq_topology, G_TYPE_OBJECT)
+
+enum seq_topology_sig_type {
+    SEQ_TOPOLOGY_SIG_TYPE_CLIENT_ADDED = 0,
+    SEQ_TOPOLOGY_SIG_TYPE_CLIENT_REMOVED,
+    SEQ_TOPOLOGY_SIG_TYPE_CLIENT_CHANGED,
+    SEQ_TOPOLOGY_SIG_TYPE_PORT_ADDED,
+    SEQ_TOPOLOGY_SIG_TYPE_PORT_REMOVED,
+    SEQ_TOPOLOGY_SIG_TYPE_PORT_CHANGED,
+    SEQ_TOPOLOGY_SIG_TYPE_SUBSCRIBED,
+    SEQ_TOPOLOGY_SIG_TYPE_UNSUBSCRIBED,
+    SEQ_TOPOLOGY_SIG_TYPE_COUNT,
+};
+static guint seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_COUNT] = { 0 };
+
+#define CLIENT_KEY(client)      GUINT_TO_POINTER(client)
+#define PORT_KEY(addr)          GUINT_TO_POINTER(((guint)(addr)->client << 8) | (addr)->port)
+#define SUBS_KEY(sender, dest)  GUINT_TO_POINTER(((guint)(sender)->client << 24) |     \
+                                                 ((guint)(sender)->port << 16) |       \
+                                                 ((guint)(dest)->client << 8) | (dest)->port)
+
+static void seq_topology_finalize(GObject *obj)
+{
+    ALSASeqTopology *self = ALSASEQ_TOPOLOGY(obj);
+    ALSASeqTopologyPrivate *priv = alsaseq_topology_get_instance_private(self);
+
+    if (priv->client != NULL)
+        g_object_unref(priv->client);
+    g_hash_table_destroy(priv->clients);
+    g_hash_table_destroy(priv->ports);
+    g_hash_table_destroy(priv->subscriptions);
+
+    G_OBJECT_CLASS(alsaseq_topology_parent_class)->finalize(obj);
+}
+
+static void alsaseq_topology_class_init(ALSASeqTopologyClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = seq_topology_finalize;
+
+    /**
+     * ALSASeqTopology::client-added:
+     * @self: A [class@Topology].
+     * @client_id: The numeric ID of client added to the topology.
+     *
+     * When any client is added to the topology, this signal is emit.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_CLIENT_ADDED] =
+        g_signal_new("client-added",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, client_added),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__UCHAR,
+                     G_TYPE_NONE, 1, G_TYPE_UCHAR);
+
+    /**
+     * ALSASeqTopology::client-removed:
+     * @self: A [class@Topology].
+     * @client_id: The numeric ID of client removed from the topology.
+     *
+     * When any client is removed from the topology, this signal is emit. The ports of client and
+     * the subscriptions for them are already removed from the topology without any signal.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_CLIENT_REMOVED] =
+        g_signal_new("client-removed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, client_removed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__UCHAR,
+                     G_TYPE_NONE, 1, G_TYPE_UCHAR);
+
+    /**
+     * ALSASeqTopology::client-changed:
+     * @self: A [class@Topology].
+     * @client_id: The numeric ID of client changed in the topology.
+     *
+     * When the information of any client is changed in the topology, this signal is emit.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_CLIENT_CHANGED] =
+        g_signal_new("client-changed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, client_changed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__UCHAR,
+                     G_TYPE_NONE, 1, G_TYPE_UCHAR);
+
+    /**
+     * ALSASeqTopology::port-added:
+     * @self: A [class@Topology].
+     * @addr: (transfer none): The address of port added to the topology.
+     *
+     * When any port is added to the topology, this signal is emit.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_PORT_ADDED] =
+        g_signal_new("port-added",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, port_added),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__BOXED,
+                     G_TYPE_NONE, 1, ALSASEQ_TYPE_ADDR);
+
+    /**
+     * ALSASeqTopology::port-removed:
+     * @self: A [class@Topology].
+     * @addr: (transfer none): The address of port removed from the topology.
+     *
+     * When any port is removed from the topology, this signal is emit. The subscriptions for the
+     * port are already removed from the topology without any signal.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_PORT_REMOVED] =
+        g_signal_new("port-removed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, port_removed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__BOXED,
+                     G_TYPE_NONE, 1, ALSASEQ_TYPE_ADDR);
+
+    /**
+     * ALSASeqTopology::port-changed:
+     * @self: A [class@Topology].
+     * @addr: (transfer none): The address of port changed in the topology.
+     *
+     * When the information of any port is changed in the topology, this signal is emit.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_PORT_CHANGED] =
+        g_signal_new("port-changed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, port_changed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__BOXED,
+                     G_TYPE_NONE, 1, ALSASEQ_TYPE_ADDR);
+
+    /**
+     * ALSASeqTopology::subscribed:
+     * @self: A [class@Topology].
+     * @subs_data: (transfer none): The data of subscription added to the topology.
+     *
+     * When any subscription is added to the topology, this signal is emit.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_SUBSCRIBED] =
+        g_signal_new("subscribed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, subscribed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__OBJECT,
+                     G_TYPE_NONE, 1, ALSASEQ_TYPE_SUBSCRIBE_DATA);
+
+    /**
+     * ALSASeqTopology::unsubscribed:
+     * @self: A [class@Topology].
+     * @subs_data: (transfer none): The data of subscription removed from the topology.
+     *
+     * When any subscription is removed from the topology, this signal is emit.
+     */
+    seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_UNSUBSCRIBED] =
+        g_signal_new("unsubscribed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqTopologyClass, unsubscribed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__OBJECT,
+                     G_TYPE_NONE, 1, ALSASEQ_TYPE_SUBSCRIBE_DATA);
+}
+
+static void alsaseq_topology_init(ALSASeqTopology *self)
+{
+    ALSASeqTopologyPrivate *priv = alsaseq_topology_get_instance_private(self);
+
+    priv->clients = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
+    priv->ports = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
+    priv->subscriptions = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                                                g_object_unref);
+}
+
+/**
+ * alsaseq_topology_new:
+ *
+ * Allocate and return an instance of [class@Topology].
+ *
+ * Returns: An instance of [class@Topology].
+ */
+ALSASeqTopology *alsaseq_topology_new()
+{
+    return g_object_new(ALSASEQ_TYPE_TOPOLOGY, NULL);
+}
+
+static gboolean seq_topology_involves_self(ALSASeqTopologyPrivate *priv,
+                                           const struct snd_seq_port_subscribe *data)
+{
+    return data->sender.client == priv->client_id || data->dest.client == priv->client_id;
+}
+
+static gboolean seq_topology_update_client(ALSASeqTopologyPrivate *priv, int fd,
+                                           guint8 client_id, gboolean *added, GError **error)
+{
+    ALSASeqClientInfo *client_info;
+
+    if (!seq_query_client_info(fd, client_id, &client_info, error))
+        return FALSE;
+
+    *added = !g_hash_table_contains(priv->clients, CLIENT_KEY(client_id));
+    g_hash_table_replace(priv->clients, CLIENT_KEY(client_id), client_info);
+
+    return TRUE;
+}
+
+static gboolean seq_topology_update_port(ALSASeqTopologyPrivate *priv, int fd,
+                                         const struct snd_seq_addr *addr, gboolean *added,
+                                         GError **error)
+{
+    ALSASeqPortInfo *port_info;
+
+    if (!seq_query_port_info(fd, addr->client, addr->port, &port_info, error))
+        return FALSE;
+
+    *added = !g_hash_table_contains(priv->ports, PORT_KEY(addr));
+    g_hash_table_replace(priv->ports, PORT_KEY(addr), port_info);
+
+    return TRUE;
+}
+
+static void seq_topology_insert_subscription(ALSASeqTopologyPrivate *priv,
+                                             ALSASeqSubscribeData *subs_data)
+{
+    struct snd_seq_port_subscribe *data;
+
+    seq_subscribe_data_refer_private(subs_data, &data);
+    g_hash_table_replace(priv->subscriptions, SUBS_KEY(&data->sender, &data->dest), subs_data);
+}
+
+static gboolean seq_topology_match_client(gpointer key, gpointer value, gpointer user_data)
+{
+    guint8 client_id = GPOINTER_TO_UINT(user_data);
+
+    return (GPOINTER_TO_UINT(key) >> 8) == client_id;
+}
+
+static gboolean seq_topology_match_subs_client(gpointer key, gpointer value, gpointer user_data)
+{
+    guint8 client_id = GPOINTER_TO_UINT(user_data);
+    guint subs_key = GPOINTER_TO_UINT(key);
+
+    return (subs_key >> 24) == client_id || ((subs_key >> 8) & 0xff) == client_id;
+}
+
+static gboolean seq_topology_match_subs_port(gpointer key, gpointer value, gpointer user_data)
+{
+    guint port_key = GPOINTER_TO_UINT(user_data);
+    guint subs_key = GPOINTER_TO_UINT(key);
+
+    return (subs_key >> 16) == port_key || (subs_key & 0xffff) == port_key;
+}
+
+static gboolean seq_topology_build(ALSASeqTopologyPrivate *priv, int fd, GError **error)
+{
+    guint8 *client_ids = NULL;
+    gsize client_count = 0;
+    gsize i;
+
+    if (!seq_query_client_id_list(fd, &client_ids, &client_count, error))
+        return FALSE;
+
+    for (i = 0; i < client_count; ++i) {
+        guint8 *port_ids = NULL;
+        gsize port_count = 0;
+        gboolean added;
+        gsize j;
+
+        if (client_ids[i] == priv->client_id)
+            continue;
+
+        // The client can exit during the build.
+        if (!seq_topology_update_client(priv, fd, client_ids[i], &added, NULL))
+            continue;
+
+        if (!seq_query_port_id_list(fd, client_ids[i], &port_ids, &port_count, NULL))
+            continue;
+
+        for (j = 0; j < port_count; ++j) {
+            struct snd_seq_addr addr = { .client = client_ids[i], .port = port_ids[j] };
+            GList *entries = NULL;
+            GList *entry;
+
+            if (!seq_topology_update_port(priv, fd, &addr, &added, NULL))
+                continue;
+
+            // The subscriptions are gathered at the side of sender.
+            if (!seq_query_subscription_list(fd, &addr, ALSASEQ_QUERY_SUBSCRIBE_TYPE_READ,
+                                             &entries, NULL))
+                continue;
+
+            for (entry = entries; entry != NULL; entry = g_list_next(entry)) {
+                ALSASeqSubscribeData *subs_data = entry->data;
+                struct snd_seq_port_subscribe *data;
+
+                seq_subscribe_data_refer_private(subs_data, &data);
+                if (seq_topology_involves_self(priv, data))
+                    g_object_unref(subs_data);
+                else
+                    seq_topology_insert_subscription(priv, subs_data);
+            }
+            g_list_free(entries);
+        }
+
+        g_free(port_ids);
+    }
+
+    g_free(client_ids);
+
+    return TRUE;
+}
+
+static void seq_topology_apply_event(ALSASeqTopology *self, const struct snd_seq_event *ev)
+{
+    ALSASeqTopologyPrivate *priv = alsaseq_topology_get_instance_private(self);
+    int fd = seq_user_client_get_fd(priv->client);
+    gboolean added;
+
+    switch (ev->type) {
+    case SNDRV_SEQ_EVENT_CLIENT_START:
+    case SNDRV_SEQ_EVENT_CLIENT_CHANGE:
+    {
+        guint8 client_id = ev->data.addr.client;
+
+        if (client_id == priv->client_id)
+            break;
+
+        if (!seq_topology_update_client(priv, fd, client_id, &added, NULL))
+            break;
+
+        if (added)
+            g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_CLIENT_ADDED], 0,
+                          client_id);
+        else
+            g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_CLIENT_CHANGED], 0,
+                          client_id);
+        break;
+    }
+    case SNDRV_SEQ_EVENT_CLIENT_EXIT:
+    {
+        guint8 client_id = ev->data.addr.client;
+
+        if (!g_hash_table_remove(priv->clients, CLIENT_KEY(client_id)))
+            break;
+
+        g_hash_table_foreach_remove(priv->ports, seq_topology_match_client,
+                                    GUINT_TO_POINTER(client_id));
+        g_hash_table_foreach_remove(priv->subscriptions, seq_topology_match_subs_client,
+                                    GUINT_TO_POINTER(client_id));
+
+        g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_CLIENT_REMOVED], 0,
+                      client_id);
+        break;
+    }
+    case SNDRV_SEQ_EVENT_PORT_START:
+    case SNDRV_SEQ_EVENT_PORT_CHANGE:
+    {
+        const struct snd_seq_addr *addr = &ev->data.addr;
+
+        if (addr->client == priv->client_id)
+            break;
+
+        if (!seq_topology_update_port(priv, fd, addr, &added, NULL))
+            break;
+
+        if (added)
+            g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_PORT_ADDED], 0, addr);
+        else
+            g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_PORT_CHANGED], 0, addr);
+        break;
+    }
+    case SNDRV_SEQ_EVENT_PORT_EXIT:
+    {
+        const struct snd_seq_addr *addr = &ev->data.addr;
+
+        if (!g_hash_table_remove(priv->ports, PORT_KEY(addr)))
+            break;
+
+        g_hash_table_foreach_remove(priv->subscriptions, seq_topology_match_subs_port,
+                                    PORT_KEY(addr));
+
+        g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_PORT_REMOVED], 0, addr);
+        break;
+    }
+    case SNDRV_SEQ_EVENT_PORT_SUBSCRIBED:
+    {
+        ALSASeqSubscribeData *subs_data;
+        struct snd_seq_port_subscribe *data;
+
+        subs_data = g_object_new(ALSASEQ_TYPE_SUBSCRIBE_DATA, NULL);
+        seq_subscribe_data_refer_private(subs_data, &data);
+        data->sender = ev->data.connect.sender;
+        data->dest = ev->data.connect.dest;
+
+        if (seq_topology_involves_self(priv, data) ||
+            ioctl(fd, SNDRV_SEQ_IOCTL_GET_SUBSCRIPTION, data) < 0) {
+            g_object_unref(subs_data);
+            break;
+        }
+
+        seq_topology_insert_subscription(priv, subs_data);
+        g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_SUBSCRIBED], 0, subs_data);
+        break;
+    }
+    case SNDRV_SEQ_EVENT_PORT_UNSUBSCRIBED:
+    {
+        gpointer key = SUBS_KEY(&ev->data.connect.sender, &ev->data.connect.dest);
+        ALSASeqSubscribeData *subs_data;
+
+        subs_data = g_hash_table_lookup(priv->subscriptions, key);
+        if (subs_data == NULL)
+            break;
+
+        g_hash_table_steal(priv->subscriptions, key);
+        g_signal_emit(self, seq_topology_sigs[SEQ_TOPOLOGY_SIG_TYPE_UNSUBSCRIBED], 0, subs_data);
+        g_object_unref(subs_data);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static void seq_topology_handle_event(ALSASeqUserClient *client, const ALSASeqEventCntr *ev_cntr,
+                                      gpointer user_data)
+{
+    ALSASeqTopology *self = ALSASEQ_TOPOLOGY(user_data);
+    gsize pos = 0;
+
+    while (pos + sizeof(struct snd_seq_event) <= ev_cntr->length) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)(ev_cntr->buf + pos);
+
+        seq_topology_apply_event(self, ev);
+        pos += seq_event_calculate_flattened_length(ev, ev_cntr->aligned);
+    }
+}
+
+/**
+ * alsaseq_topology_open:
+ * @self: A [class@Topology].
+ * @open_flag: The flag of `open(2)` system call. `O_RDWR` is forced to fulfil internally.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Open ALSA sequencer character device as an internal client, add a port to the client and
+ * subscribe the port of system announce, then build the snapshot of topology.
+ *
+ * The call of function executes `open(2)` system call, then executes `ioctl(2)` system calls for
+ * ALSA sequencer character device to add the port, to establish the subscription, and to query
+ * clients, ports, and subscriptions.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_topology_open(ALSASeqTopology *self, gint open_flag, GError **error)
+{
+    ALSASeqTopologyPrivate *priv;
+    ALSASeqUserClient *client;
+    ALSASeqPortInfo *port_info;
+    ALSASeqSubscribeData *subs_data;
+    ALSASeqAddr *sender;
+    ALSASeqAddr *dest;
+    gboolean result;
+
+    g_return_val_if_fail(ALSASEQ_IS_TOPOLOGY(self), FALSE);
+    priv = alsaseq_topology_get_instance_private(self);
+
+    g_return_val_if_fail(priv->client == NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    client = alsaseq_user_client_new();
+    if (!alsaseq_user_client_open(client, open_flag, error)) {
+        g_object_unref(client);
+        return FALSE;
+    }
+    g_object_get(client, "client-id", &priv->client_id, NULL);
+
+    port_info = alsaseq_port_info_new();
+    g_object_set(port_info,
+                 "name", "topology",
+                 "caps", ALSASEQ_PORT_CAP_FLAG_WRITE | ALSASEQ_PORT_CAP_FLAG_SUBS_WRITE,
+                 "attrs", ALSASEQ_PORT_ATTR_FLAG_APPLICATION,
+                 NULL);
+    result = alsaseq_user_client_create_port(client, &port_info, error);
+    if (!result) {
+        g_object_unref(port_info);
+        g_object_unref(client);
+        return FALSE;
+    }
+    g_object_get(port_info, "addr", &dest, NULL);
+    g_object_unref(port_info);
+
+    sender = alsaseq_addr_new(ALSASEQ_SPECIFIC_CLIENT_ID_SYSTEM,
+                              ALSASEQ_SPECIFIC_PORT_ID_SYSTEM_ANNOUNCE);
+    subs_data = alsaseq_subscribe_data_new();
+    g_object_set(subs_data, "sender", sender, "dest", dest, NULL);
+    g_boxed_free(ALSASEQ_TYPE_ADDR, sender);
+    g_boxed_free(ALSASEQ_TYPE_ADDR, dest);
+
+    result = alsaseq_user_client_operate_subscription(client, subs_data, TRUE, error);
+    g_object_unref(subs_data);
+    if (!result) {
+        g_object_unref(client);
+        return FALSE;
+    }
+
+    // The announcements after the subscription are applied as delta.
+    if (!seq_topology_build(priv, seq_user_client_get_fd(client), error)) {
+        g_hash_table_remove_all(priv->clients);
+        g_hash_table_remove_all(priv->ports);
+        g_hash_table_remove_all(priv->subscriptions);
+        g_object_unref(client);
+        return FALSE;
+    }
+
+    // The source can keep the client after finalization of the topology.
+    g_signal_connect_object(client, "handle-event", (GCallback)seq_topology_handle_event, self,
+                            0);
+    priv->client = client;
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_topology_create_source:
+ * @self: A [class@Topology].
+ * @gsrc: (out): A #GSource to handle the announcements from ALSA sequencer.
+ * @error: A [struct@GLib.Error].
+ *
+ * Allocate [struct@GLib.Source] structure to handle the announcements from ALSA sequencer. The
+ * snapshot of topology is updated and the signals are emitted in the dispatcher.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_topology_create_source(ALSASeqTopology *self, GSource **gsrc, GError **error)
+{
+    ALSASeqTopologyPrivate *priv;
+
+    g_return_val_if_fail(ALSASEQ_IS_TOPOLOGY(self), FALSE);
+    priv = alsaseq_topology_get_instance_private(self);
+    g_return_val_if_fail(priv->client != NULL, FALSE);
+
+    return alsaseq_user_client_create_source(priv->client, gsrc, error);
+}
+
+static gint seq_topology_compare_id(gconstpointer a, gconstpointer b)
+{
+    return *(const guint8 *)a - *(const guint8 *)b;
+}
+
+/**
+ * alsaseq_topology_get_client_id_list:
+ * @self: A [class@Topology].
+ * @entries: (array length=entry_count)(out): The array with elements for numeric identifier of
+ *           client in the snapshot.
+ * @entry_count: The number of entries.
+ *
+ * Get the list of clients in the snapshot as the numeric identifier, in ascending order.
+ */
+void alsaseq_topology_get_client_id_list(ALSASeqTopology *self, guint8 **entries,
+                                         gsize *entry_count)
+{
+    ALSASeqTopologyPrivate *priv;
+    GHashTableIter iter;
+    gpointer key;
+    guint8 *list;
+    gsize count;
+
+    g_return_if_fail(ALSASEQ_IS_TOPOLOGY(self));
+    priv = alsaseq_topology_get_instance_private(self);
+
+    g_return_if_fail(entries != NULL);
+    g_return_if_fail(entry_count != NULL);
+
+    list = g_malloc0_n(MAX(g_hash_table_size(priv->clients), 1), sizeof(*list));
+    count = 0;
+
+    g_hash_table_iter_init(&iter, priv->clients);
+    while (g_hash_table_iter_next(&iter, &key, NULL))
+        list[count++] = GPOINTER_TO_UINT(key);
+
+    qsort(list, count, sizeof(*list), seq_topology_compare_id);
+
+    *entries = list;
+    *entry_count = count;
+}
+
+/**
+ * alsaseq_topology_get_client_info:
+ * @self: A [class@Topology].
+ * @client_id: The numeric identifier of client.
+ * @client_info: (out)(transfer full): A [class@ClientInfo] for the client in the snapshot.
+ *
+ * Get the information of client in the snapshot.
+ *
+ * Returns: %TRUE when the client is in the snapshot, else %FALSE.
+ */
+gboolean alsaseq_topology_get_client_info(ALSASeqTopology *self, guint8 client_id,
+                                          ALSASeqClientInfo **client_info)
+{
+    ALSASeqTopologyPrivate *priv;
+    ALSASeqClientInfo *info;
+
+    g_return_val_if_fail(ALSASEQ_IS_TOPOLOGY(self), FALSE);
+    priv = alsaseq_topology_get_instance_private(self);
+
+    g_return_val_if_fail(client_info != NULL, FALSE);
+
+    info = g_hash_table_lookup(priv->clients, CLIENT_KEY(client_id));
+    if (info == NULL)
+        return FALSE;
+
+    *client_info = g_object_ref(info);
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_topology_get_port_id_list:
+ * @self: A [class@Topology].
+ * @client_id: The numeric identifier of client.
+ * @entries: (array length=entry_count)(out): The array with elements for numeric identifier of
+ *           port in the snapshot.
+ * @entry_count: The number of entries.
+ *
+ * Get the list of ports for the client in the snapshot as the numeric identifier, in ascending
+ * order.
+ *
+ * Returns: %TRUE when the client is in the snapshot, else %FALSE.
+ */
+gboolean alsaseq_topology_get_port_id_list(ALSASeqTopology *self, guint8 client_id,
+                                           guint8 **entries, gsize *entry_count)
+{
+    ALSASeqTopologyPrivate *priv;
+    GHashTableIter iter;
+    gpointer key;
+    guint8 *list;
+    gsize count;
+
+    g_return_val_if_fail(ALSASEQ_IS_TOPOLOGY(self), FALSE);
+    priv = alsaseq_topology_get_instance_private(self);
+
+    g_return_val_if_fail(entries != NULL, FALSE);
+    g_return_val_if_fail(entry_count != NULL, FALSE);
+
+    if (!g_hash_table_contains(priv->clients, CLIENT_KEY(client_id)))
+        return FALSE;
+
+    list = g_malloc0_n(G_MAXUINT8 + 1, sizeof(*list));
+    count = 0;
+
+    g_hash_table_iter_init(&iter, priv->ports);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        guint port_key = GPOINTER_TO_UINT(key);
+
+        if ((port_key >> 8) == client_id)
+            list[count++] = port_key & 0xff;
+    }
+
+    qsort(list, count, sizeof(*list), seq_topology_compare_id);
+
+    *entries = list;
+    *entry_count = count;
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_topology_get_port_info:
+ * @self: A [class@Topology].
+ * @client_id: The numeric identifier of client.
+ * @port_id: The numeric identifier of port in the client.
+ * @port_info: (out)(transfer full): A [class@PortInfo] for the port in the snapshot.
+ *
+ * Get the information of port in the snapshot.
+ *
+ * Returns: %TRUE when the port is in the snapshot, else %FALSE.
+ */
+gboolean alsaseq_topology_get_port_info(ALSASeqTopology *self, guint8 client_id, guint8 port_id,
+                                        ALSASeqPortInfo **port_info)
+{
+    ALSASeqTopologyPrivate *priv;
+    struct snd_seq_addr addr = { .client = client_id, .port = port_id };
+    ALSASeqPortInfo *info;
+
+    g_return_val_if_fail(ALSASEQ_IS_TOPOLOGY(self), FALSE);
+    priv = alsaseq_topology_get_instance_private(self);
+
+    g_return_val_if_fail(port_info != NULL, FALSE);
+
+    info = g_hash_table_lookup(priv->ports, PORT_KEY(&addr));
+    if (info == NULL)
+        return FALSE;
+
+    *port_info = g_object_ref(info);
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_topology_get_subscription_list:
+ * @self: A [class@Topology].
+ * @addr: A [struct@Addr] to query.
+ * @query_type: The type of query, one of [enum@QuerySubscribeType].
+ * @entries: (element-type ALSASeq.SubscribeData)(out)(transfer full): The list with element for
+ *           subscription data in the snapshot.
+ *
+ * Get the list of subscription in the snapshot for given address and query type.
+ */
+void alsaseq_topology_get_subscription_list(ALSASeqTopology *self, const ALSASeqAddr *addr,
+                                            ALSASeqQuerySubscribeType query_type,
+                                            GList **entries)
+{
+    ALSASeqTopologyPrivate *priv;
+    GHashTableIter iter;
+    gpointer value;
+
+    g_return_if_fail(ALSASEQ_IS_TOPOLOGY(self));
+    priv = alsaseq_topology_get_instance_private(self);
+
+    g_return_if_fail(addr != NULL);
+    g_return_if_fail(entries != NULL);
+
+    g_hash_table_iter_init(&iter, priv->subscriptions);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        struct snd_seq_port_subscribe *data;
+        const struct snd_seq_addr *target;
+
+        seq_subscribe_data_refer_private(value, &data);
+        if (query_type == ALSASEQ_QUERY_SUBSCRIBE_TYPE_READ)
+            target = &data->sender;
+        else
+            target = &data->dest;
+
+        if (target->client == addr->client && target->port == addr->port)
+            *entries = g_list_prepend(*entries, g_object_ref(value));
+    }
+}
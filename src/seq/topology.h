@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_TOPOLOGY_H__
+#define __ALSA_GOBJECT_ALSASEQ_TOPOLOGY_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_TOPOLOGY    (alsaseq_topology_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(ALSASeqTopology, alsaseq_topology, ALSASEQ, TOPOLOGY, GObject);
+
+struct _ALSASeqTopologyClass {
+    GObjectClass parent_class;
+
+    /**
+     * ALSASeqTopologyClass::client_added:
+     * @self: A [class@Topology].
+     * @client_id: The numeric ID of client added to the topology.
+     *
+     * Class closure for the [signal@Topology::client-added] signal.
+     */
+    void (*client_added)(ALSASeqTopology *self, guint8 client_id);
+
+    /**
+     * ALSASeqTopologyClass::client_removed:
+     * @self: A [class@Topology].
+     * @client_id: The numeric ID of client removed from the topology.
+     *
+     * Class closure for the [signal@Topology::client-removed] signal.
+     */
+    void (*client_removed)(ALSASeqTopology *self, guint8 client_id);
+
+    /**
+     * ALSASeqTopologyClass::client_changed:
+     * @self: A [class@Topology].
+     * @client_id: The numeric ID of client changed in the topology.
+     *
+     * Class closure for the [signal@Topology::client-changed] signal.
+     */
+    void (*client_changed)(ALSASeqTopology *self, guint8 client_id);
+
+    /**
+     * ALSASeqTopologyClass::port_added:
+     * @self: A [class@Topology].
+     * @addr: (transfer none): The address of port added to the topology.
+     *
+     * Class closure for the [signal@Topology::port-added] signal.
+     */
+    void (*port_added)(ALSASeqTopology *self, const ALSASeqAddr *addr);
+
+    /**
+     * ALSASeqTopologyClass::port_removed:
+     * @self: A [class@Topology].
+     * @addr: (transfer none): The address of port removed from the topology.
+     *
+     * Class closure for the [signal@Topology::port-removed] signal.
+     */
+    void (*port_removed)(ALSASeqTopology *self, const ALSASeqAddr *addr);
+
+    /**
+     * ALSASeqTopologyClass::port_changed:
+     * @self: A [class@Topology].
+     * @addr: (transfer none): The address of port changed in the topology.
+     *
+     * Class closure for the [signal@Topology::port-changed] signal.
+     */
+    void (*port_changed)(ALSASeqTopology *self, const ALSASeqAddr *addr);
+
+    /**
+     * ALSASeqTopologyClass::subscribed:
+     * @self: A [class@Topology].
+     * @subs_data: (transfer none): The data of subscription added to the topology.
+     *
+     * Class closure for the [signal@Topology::subscribed] signal.
+     */
+    void (*subscribed)(ALSASeqTopology *self, ALSASeqSubscribeData *subs_data);
+
+    /**
+     * ALSASeqTopologyClass::unsubscribed:
+     * @self: A [class@Topology].
+     * @subs_data: (transfer none): The data of subscription removed from the topology.
+     *
+     * Class closure for the [signal@Topology::unsubscribed] signal.
+     */
+    void (*unsubscribed)(ALSASeqTopology *self, ALSASeqSubscribeData *subs_data);
+};
+
+ALSASeqTopology *alsaseq_topology_new();
+
+gboolean alsaseq_topology_open(ALSASeqTopology *self, gint open_flag, GError **error);
+
+gboolean alsaseq_topology_create_source(ALSASeqTopology *self, GSource **gsrc, GError **error);
+
+void alsaseq_topology_get_client_id_list(ALSASeqTopology *self, guint8 **entries,
+                                         gsize *entry_count);
+
+gboolean alsaseq_topology_get_client_info(ALSASeqTopology *self, guint8 client_id,
+                                          ALSASeqClientInfo **client_info);
+
+gboolean alsaseq_topology_get_port_id_list(ALSASeqTopology *self, guint8 client_id,
+                                           guint8 **entries, gsize *entry_count);
+
+gboolean alsaseq_topology_get_port_info(ALSASeqTopology *self, guint8 client_id, guint8 port_id,
+                                        ALSASeqPortInfo **port_info);
+
+void alsaseq_topology_get_subscription_list(ALSASeqTopology *self, const ALSASeqAddr *addr,
+                                            ALSASeqQuerySubscribeType query_type,
+                                            GList **entries);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "privates.h"
+
+/**
+ * ALSASeqUserClientStats:
+ * @events_read: The number of events read from the character device.
+ * @bytes_read: The number of bytes read from the character device.
+ * @read_calls: The number of `read(2)` calls which returned any event.
+ * @dispatches: The number of dispatches of [struct@GLib.Source] which read any event.
+ * @max_batch: The largest number of events returned by single `read(2)` call.
+ * @events_written: The number of events written to the character device.
+ * @bytes_written: The number of bytes written to the character device.
+ * @write_calls: The number of `write(2)` calls.
+ * @eagain_count: The number of `write(2)` calls failed with `EAGAIN`.
+ * @enomem_count: The number of `write(2)` calls failed with `ENOMEM`.
+ * @handler_time: The total time spent in handlers of [signal@UserClient::handle-event] and
+ *                [signal@UserClient::handle-typed-event] signals in nanosecond unit.
+ * @events_coalesced: The number of events dropped in the output queue by coalescing.
+ * @events_dropped: The number of events dropped in the output queue due to failure of `write(2)`.
+ * @events_unforwarded: The number of events which fail to be forwarded due to failure of
+ *                      `write(2)`.
+ *
+ * A boxed object to express snapshot of statistics in user client.
+ *
+ * A [struct@UserClientStats] is a boxed object to express snapshot of counters maintained by
+ * [class@UserClient] for throughput and batching of events. The snapshot is retrieved by
+ * [method@UserClient.get_stats].
+ */
+ALSASeqUserClientStats *seq_user_client_stats_copy(const ALSASeqUserClientStats *self)
+{
+#ifdef g_memdup2
+    return g_memdup2(self, sizeof(*self));
+#else
+    // GLib v2.68 deprecated g_memdup() with concern about overflow by narrow conversion from size_t to
+    // unsigned int however it's safe in the local case.
+    gpointer ptr = g_malloc(sizeof(*self));
+    memcpy(ptr, self, sizeof(*self));
+    return ptr;
+#endif
+}
+
+G_DEFINE_BOXED_TYPE(ALSASeqUserClientStats, alsaseq_user_client_stats, seq_user_client_stats_copy, g_free)
+
+/**
+ * alsaseq_user_client_stats_get_mean_batch_size:
+ * @self: A [struct@UserClientStats].
+ * @size: (out): The mean number of events returned by single `read(2)` call.
+ *
+ * Get the mean number of events returned by single `read(2)` call.
+ */
+void alsaseq_user_client_stats_get_mean_batch_size(const ALSASeqUserClientStats *self,
+                                                   gdouble *size)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(size != NULL);
+
+    *size = self->read_calls > 0 ? (gdouble)self->events_read / self->read_calls : 0.0;
+}
+
+/**
+ * alsaseq_user_client_stats_get_reads_per_dispatch:
+ * @self: A [struct@UserClientStats].
+ * @count: (out): The mean number of `read(2)` calls in single dispatch of [struct@GLib.Source].
+ *
+ * Get the mean number of `read(2)` calls in single dispatch of [struct@GLib.Source].
+ */
+void alsaseq_user_client_stats_get_reads_per_dispatch(const ALSASeqUserClientStats *self,
+                                                      gdouble *count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = self->dispatches > 0 ? (gdouble)self->read_calls / self->dispatches : 0.0;
+}
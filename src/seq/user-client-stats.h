@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef __ALSA_GOBJECT_ALSASEQ_USER_CLIENT_STATS_H__
+#define __ALSA_GOBJECT_ALSASEQ_USER_CLIENT_STATS_H__
+
+#include <alsaseq.h>
+
+G_BEGIN_DECLS
+
+#define ALSASEQ_TYPE_USER_CLIENT_STATS  (alsaseq_user_client_stats_get_type())
+
+typedef struct {
+    guint64 events_read;
+    guint64 bytes_read;
+    guint64 read_calls;
+    guint64 dispatches;
+    guint64 max_batch;
+    guint64 events_written;
+    guint64 bytes_written;
+    guint64 write_calls;
+    guint64 eagain_count;
+    guint64 enomem_count;
+    guint64 handler_time;
+    guint64 events_coalesced;
+    guint64 events_dropped;
+    guint64 events_unforwarded;
+} ALSASeqUserClientStats;
+
+GType alsaseq_user_client_stats_get_type() G_GNUC_CONST;
+
+void alsaseq_user_client_stats_get_mean_batch_size(const ALSASeqUserClientStats *self,
+                                                   gdouble *size);
+
+void alsaseq_user_client_stats_get_reads_per_dispatch(const ALSASeqUserClientStats *self,
+                                                      gdouble *count);
+
+G_END_DECLS
+
+#endif
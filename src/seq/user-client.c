@@ -8,7 +8,12 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
 #include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
 
 /**
  * ALSASeqUserClient:
@@ -24,11 +29,43 @@
  * [signal@UserClient::handle-event] signal is emitted in the event dispatcher to notify the
  * event. The call of [method@UserClient.schedule_event] schedules event with given parameters.
  */
+// The slot of direct-mapped table to find the former event for coalescing.
+typedef struct {
+    guint64 key;
+    guint32 param;
+    guint generation;
+    gsize offset;
+    gsize index;
+} CoalescingSlot;
+
+// The slot of direct-mapped table to find the last event queued for the destination and channel.
+typedef struct {
+    guint64 key;
+    guint generation;
+    gsize index;
+} CoalescingChannel;
+
 typedef struct {
     int fd;
     const char *devnode;
     int client_id;
     guint16 proto_ver_triplet[3];
+    ALSASeqEventCntr send_arena;
+    gsize send_arena_limit;
+    guint8 *output_queue;
+    gsize output_queue_size;
+    gsize output_queue_length;
+    gsize output_queue_depth;
+    ALSASeqUserClientStats stats;
+    GArray *forward_routes;
+    guint barrier_token;
+    guint pending_barriers;
+    guint coalescing_window;
+    CoalescingSlot *coalescing_slots;
+    CoalescingChannel *coalescing_channels;
+    guint coalescing_generation;
+    gsize coalescing_barrier;
+    gsize pointer_data_threshold;
 } ALSASeqUserClientPrivate;
 G_DEFINE_TYPE_WITH_PRIVATE(ALSASeqUserClient, alsaseq_user_client, G_TYPE_OBJECT)
 
@@ -54,26 +91,359 @@ static const char *const err_msgs[] = {
         g_set_error(exception, ALSASEQ_USER_CLIENT_ERROR, ALSASEQ_USER_CLIENT_ERROR_FAILED, \
                     fmt" %d(%s)", arg, errno, strerror(errno))
 
+// The counters of statistics are updated by the thread to schedule events as well as the thread
+// to dispatch the source, and loaded by any thread, thus the atomic operation is required.
+#define stats_add(priv, field, val) \
+        __atomic_fetch_add(&(priv)->stats.field, (val), __ATOMIC_RELAXED)
+#define stats_load(priv, field) \
+        __atomic_load_n(&(priv)->stats.field, __ATOMIC_RELAXED)
+#define stats_store(priv, field, val) \
+        __atomic_store_n(&(priv)->stats.field, (val), __ATOMIC_RELAXED)
+
+// The number of slots in the table for coalescing.
+#define COALESCING_SLOT_COUNT       256
+
+// The marker in the echo event scheduled as barrier.
+#define SEQ_BARRIER_MAGIC   0x42415252      // 'BARR'
+
+static void seq_user_client_count_write_error(ALSASeqUserClientPrivate *priv, int err)
+{
+    if (err == EAGAIN)
+        stats_add(priv, eagain_count, 1);
+    else if (err == ENOMEM)
+        stats_add(priv, enomem_count, 1);
+}
+
+// The maximum is updated by the main source and the reader thread, thus compare-and-swap is used
+// not to lose it.
+static void seq_user_client_update_max_batch(ALSASeqUserClientPrivate *priv, guint64 count)
+{
+    guint64 cur = stats_load(priv, max_batch);
+
+    while (count > cur &&
+           !__atomic_compare_exchange_n(&priv->stats.max_batch, &cur, count, FALSE,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+static void seq_user_client_count_written(ALSASeqUserClientPrivate *priv, gsize bytes,
+                                          gsize events)
+{
+    stats_add(priv, write_calls, 1);
+    stats_add(priv, bytes_written, bytes);
+    stats_add(priv, events_written, events);
+}
+
+// The send arena is used to flatten events for write(2). It grows when the events are larger than
+// it, then shrinks to the limit after used.
+static void seq_user_client_release_send_arena(ALSASeqUserClientPrivate *priv)
+{
+    ALSASeqEventCntr *arena = &priv->send_arena;
+
+    arena->length = 0;
+
+    if (priv->send_arena_limit > 0 && arena->capacity > priv->send_arena_limit) {
+        arena->buf = g_realloc(arena->buf, priv->send_arena_limit);
+        arena->capacity = priv->send_arena_limit;
+    }
+}
+
+// Count events in the flattened buffer without alignment.
+static gsize seq_user_client_count_events(const guint8 *buf, gsize length)
+{
+    gsize pos = 0;
+    gsize count = 0;
+
+    while (pos < length) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)(buf + pos);
+
+        pos += seq_event_calculate_flattened_length(ev, FALSE);
+        ++count;
+    }
+
+    return count;
+}
+
+// The blob is read by ALSA Sequencer core from user space just during the call of write(2), while
+// the events in output queue are written later. The conversion is therefore done only when the
+// output queue is disabled.
+static gsize seq_user_client_get_pointer_data_threshold(const ALSASeqUserClientPrivate *priv)
+{
+    return priv->output_queue_size == 0 ? priv->pointer_data_threshold : 0;
+}
+
+// The type of destination client is cached in the call of schedule functions.
+typedef struct {
+    int fd;
+    gsize threshold;
+    guint8 queried[(SNDRV_SEQ_ADDRESS_BROADCAST + 1) / 8];
+    guint8 kernel[(SNDRV_SEQ_ADDRESS_BROADCAST + 1) / 8];
+} PointerDataContext;
+
+// ALSA Sequencer core copies the blob pointed by the event of VARUSR just for the destination of
+// kernel client, while the destination of user client receives the pointer itself. The event is
+// therefore converted only when the destination is kernel client, never for subscribers.
+static gboolean seq_user_client_deliver_by_pointer(const ALSASeqEvent *event, gpointer user_data)
+{
+    PointerDataContext *ctx = user_data;
+    guint8 client = event->dest.client;
+    guint8 bit = 1u << (client % 8);
+
+    if (!seq_event_is_pointer_data_candidate(event, ctx->threshold) ||
+        client == SNDRV_SEQ_ADDRESS_SUBSCRIBERS || client == SNDRV_SEQ_ADDRESS_BROADCAST)
+        return FALSE;
+
+    if (!(ctx->queried[client / 8] & bit)) {
+        struct snd_seq_client_info info = { .client = client };
+
+        ctx->queried[client / 8] |= bit;
+        if (ioctl(ctx->fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, &info) == 0 &&
+            info.type == KERNEL_CLIENT)
+            ctx->kernel[client / 8] |= bit;
+    }
+
+    return !!(ctx->kernel[client / 8] & bit);
+}
+
+// The controllers with state or meaning in the sequence of events are not coalesced; bank select,
+// data entry, switches, data increment/decrement, NRPN/RPN, and channel mode messages.
+static gboolean seq_user_client_is_stateful_controller(guint32 param)
+{
+    switch (param) {
+    case 0:             // Bank select MSB.
+    case 6:             // Data entry MSB.
+    case 32:            // Bank select LSB.
+    case 38:            // Data entry LSB.
+    case 64 ... 69:     // Damper pedal, portamento, sostenuto, soft pedal, legato, hold 2.
+    case 96 ... 101:    // Data increment/decrement, NRPN LSB/MSB, RPN LSB/MSB.
+        return TRUE;
+    default:
+        return param >= 120;
+    }
+}
+
+// Return TRUE when the event is subject to coalescing, and compute the key for it. The events
+// delivered directly are just subject since the other events are delivered at the time stamp.
+static gboolean seq_user_client_coalescing_key(const struct snd_seq_event *ev, guint64 *key,
+                                               guint32 *param)
+{
+    if (ev->queue != SNDRV_SEQ_QUEUE_DIRECT ||
+        (ev->flags & SNDRV_SEQ_EVENT_LENGTH_MASK) != SNDRV_SEQ_EVENT_LENGTH_FIXED)
+        return FALSE;
+
+    switch (ev->type) {
+    case SNDRV_SEQ_EVENT_CONTROLLER:
+        if (seq_user_client_is_stateful_controller(ev->data.control.param))
+            return FALSE;
+        *param = ev->data.control.param;
+        break;
+    case SNDRV_SEQ_EVENT_PITCHBEND:
+    case SNDRV_SEQ_EVENT_CHANPRESS:
+        *param = 0;
+        break;
+    default:
+        return FALSE;
+    }
+
+    *key = ((guint64)ev->type << 40) | ((guint64)ev->dest.client << 32) |
+           ((guint64)ev->dest.port << 24) | ((guint64)ev->source.port << 16) |
+           ev->data.control.channel;
+
+    return TRUE;
+}
+
+// Record the event as the last one queued for the destination and channel. The system exclusive
+// and reset events can change the state of any channel, thus they are recorded as barrier.
+static void seq_user_client_record_coalescing_channel(ALSASeqUserClientPrivate *priv,
+                                                      const struct snd_seq_event *ev)
+{
+    // The data of note and control events begins with channel.
+    if (ev->type >= SNDRV_SEQ_EVENT_NOTE && ev->type <= SNDRV_SEQ_EVENT_REGPARAM) {
+        guint64 key = ((guint64)ev->dest.client << 32) | ((guint64)ev->dest.port << 24) |
+                      ((guint64)ev->source.port << 16) | ev->data.note.channel;
+        CoalescingChannel *slot = priv->coalescing_channels +
+                                  (key ^ (key >> 24)) % COALESCING_SLOT_COUNT;
+
+        // The slot is overwritten by the other key at collision, then the former event for the
+        // key is not coalesced anymore.
+        slot->key = key;
+        slot->generation = priv->coalescing_generation;
+        slot->index = priv->output_queue_depth;
+    } else if (ev->type == SNDRV_SEQ_EVENT_SYSEX || ev->type == SNDRV_SEQ_EVENT_RESET ||
+               (ev->flags & SNDRV_SEQ_EVENT_LENGTH_MASK) != SNDRV_SEQ_EVENT_LENGTH_FIXED) {
+        priv->coalescing_barrier = priv->output_queue_depth + 1;
+    }
+}
+
+// Return TRUE when the event at the index is the last one queued for the destination and channel
+// of the event.
+static gboolean seq_user_client_is_last_in_channel(const ALSASeqUserClientPrivate *priv,
+                                                   const struct snd_seq_event *ev, gsize index)
+{
+    guint64 key = ((guint64)ev->dest.client << 32) | ((guint64)ev->dest.port << 24) |
+                  ((guint64)ev->source.port << 16) | ev->data.control.channel;
+    const CoalescingChannel *slot = priv->coalescing_channels +
+                                    (key ^ (key >> 24)) % COALESCING_SLOT_COUNT;
+
+    return slot->generation == priv->coalescing_generation && slot->key == key &&
+           slot->index == index && index >= priv->coalescing_barrier;
+}
+
+// Coalesce the events appended to the output queue at the offset. When the former event with the
+// same key is pending in the queue and no other event for the same destination and channel is
+// queued after it, the value of the latter event is overwritten to the former event, then the
+// latter event is dropped. Therefore the events for the destination and channel are not
+// re-ordered.
+static void seq_user_client_coalesce_output_queue(ALSASeqUserClientPrivate *priv, gsize offset)
+{
+    gsize read_pos = offset;
+    gsize write_pos = offset;
+
+    while (read_pos < priv->output_queue_length) {
+        struct snd_seq_event *ev = (struct snd_seq_event *)(priv->output_queue + read_pos);
+        gsize length = seq_event_calculate_flattened_length(ev, FALSE);
+        guint64 key;
+        guint32 param;
+
+        if (seq_user_client_coalescing_key(ev, &key, &param)) {
+            CoalescingSlot *slot = priv->coalescing_slots +
+                                   (key ^ (key >> 24) ^ param * 0x9e3779b1u) %
+                                   COALESCING_SLOT_COUNT;
+
+            if (slot->generation == priv->coalescing_generation && slot->key == key &&
+                slot->param == param &&
+                priv->output_queue_depth - slot->index < priv->coalescing_window &&
+                seq_user_client_is_last_in_channel(priv, ev, slot->index)) {
+                struct snd_seq_event *former =
+                                (struct snd_seq_event *)(priv->output_queue + slot->offset);
+
+                former->data.control.value = ev->data.control.value;
+                stats_add(priv, events_coalesced, 1);
+                read_pos += length;
+                continue;
+            }
+
+            // The slot is overwritten by the other key at collision.
+            slot->key = key;
+            slot->param = param;
+            slot->generation = priv->coalescing_generation;
+            slot->offset = write_pos;
+            slot->index = priv->output_queue_depth;
+        }
+
+        seq_user_client_record_coalescing_channel(priv, ev);
+
+        if (write_pos != read_pos)
+            memmove(priv->output_queue + write_pos, ev, length);
+        write_pos += length;
+        read_pos += length;
+        ++priv->output_queue_depth;
+    }
+
+    priv->output_queue_length = write_pos;
+}
+
+// Invalidate all of slots for coalescing since the offset of events in the queue is changed.
+static void seq_user_client_invalidate_coalescing(ALSASeqUserClientPrivate *priv)
+{
+    if (++priv->coalescing_generation == 0)
+        ++priv->coalescing_generation;
+    priv->coalescing_barrier = 0;
+}
+
+// Write the flattened events. When the output queue is enabled, the events which can not be
+// written due to EAGAIN are queued so that they are flushed by the source later. The events are
+// also queued when the queue is not empty, to keep the order of events.
+static gboolean seq_user_client_write(ALSASeqUserClientPrivate *priv, const guint8 *buf,
+                                      gsize length, gsize *written, GError **error)
+{
+    ssize_t result;
+
+    if (priv->output_queue_length > 0) {
+        result = 0;
+    } else {
+        result = write(priv->fd, buf, length);
+        if (result < 0) {
+            seq_user_client_count_write_error(priv, errno);
+            if (errno != EAGAIN || priv->output_queue_size == 0) {
+                GFileError code = g_file_error_from_errno(errno);
+
+                if (code != G_FILE_ERROR_FAILED)
+                    generate_file_error(error, errno, "write(%s)", priv->devnode);
+                else
+                    generate_syscall_error(error, errno, "write(%s)", priv->devnode);
+
+                return FALSE;
+            }
+            result = 0;
+        } else {
+            seq_user_client_count_written(priv, result,
+                                          seq_user_client_count_events(buf, result));
+        }
+    }
+
+    if (result < length && priv->output_queue_size > 0) {
+        gsize rest = length - result;
+
+        if (priv->output_queue_length + rest > priv->output_queue_size) {
+            // The queue is full as well.
+            if (result == 0) {
+                generate_file_error(error, EAGAIN, "write(%s)", priv->devnode);
+                return FALSE;
+            }
+        } else {
+            gsize offset = priv->output_queue_length;
+
+            memcpy(priv->output_queue + offset, buf + result, rest);
+            priv->output_queue_length += rest;
+            if (priv->coalescing_window > 0) {
+                seq_user_client_coalesce_output_queue(priv, offset);
+            } else {
+                priv->output_queue_depth += seq_user_client_count_events(buf + result, rest);
+            }
+            result = length;
+        }
+    }
+
+    *written = result;
+
+    return TRUE;
+}
+
 typedef struct {
     GSource src;
     ALSASeqUserClient *self;
     gpointer tag;
+    GIOCondition events;
     void *buf;
     size_t buf_len;
+    guint max_reads;
 } UserClientSource;
 
 enum seq_user_client_prop_type {
     SEQ_USER_CLIENT_PROP_CLIENT_ID = 1,
+    SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_SIZE,
+    SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_LENGTH,
+    SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_DEPTH,
     SEQ_USER_CLIENT_PROP_COUNT,
 };
 static GParamSpec *seq_user_client_props[SEQ_USER_CLIENT_PROP_COUNT] = { NULL, };
 
 enum seq_user_client_sig_type {
     SEQ_USER_CLIENT_SIG_TYPE_HANDLE_EVENT = 0,
+    SEQ_USER_CLIENT_SIG_TYPE_HANDLE_TYPED_EVENT,
+    SEQ_USER_CLIENT_SIG_TYPE_FLUSHED,
+    SEQ_USER_CLIENT_SIG_TYPE_HANDLE_TIMESTAMPED_EVENT,
+    SEQ_USER_CLIENT_SIG_TYPE_LOST_COUNT_CHANGED,
+    SEQ_USER_CLIENT_SIG_TYPE_BARRIER_REACHED,
+    SEQ_USER_CLIENT_SIG_TYPE_POOL_RESIZE_FAILED,
     SEQ_USER_CLIENT_SIG_TYPE_COUNT,
 };
 static guint seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_COUNT] = { 0 };
 
+// The detail of signal for each type of event.
+static GQuark seq_user_client_event_type_details[G_MAXUINT8 + 1] = { 0 };
+
 static void seq_user_client_get_property(GObject *obj, guint id, GValue *val,
                                          GParamSpec *spec)
 {
@@ -85,6 +455,15 @@ static void seq_user_client_get_property(GObject *obj, guint id, GValue *val,
     case SEQ_USER_CLIENT_PROP_CLIENT_ID:
         g_value_set_uchar(val, (guint8)priv->client_id);
         break;
+    case SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_SIZE:
+        g_value_set_uint64(val, priv->output_queue_size);
+        break;
+    case SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_LENGTH:
+        g_value_set_uint64(val, priv->output_queue_length);
+        break;
+    case SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_DEPTH:
+        g_value_set_uint64(val, priv->output_queue_depth);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
         break;
@@ -100,6 +479,11 @@ static void seq_user_client_finalize(GObject *obj)
     if (priv->fd >= 0)
         close(priv->fd);
     g_free((gpointer)priv->devnode);
+    g_free(priv->send_arena.buf);
+    g_free(priv->output_queue);
+    g_array_free(priv->forward_routes, TRUE);
+    g_free(priv->coalescing_slots);
+    g_free(priv->coalescing_channels);
 
     G_OBJECT_CLASS(alsaseq_user_client_parent_class)->finalize(obj);
 }
@@ -107,6 +491,8 @@ static void seq_user_client_finalize(GObject *obj)
 static void alsaseq_user_client_class_init(ALSASeqUserClientClass *klass)
 {
     GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GEnumClass *enum_class;
+    guint i;
 
     gobject_class->finalize = seq_user_client_finalize;
     gobject_class->get_property = seq_user_client_get_property;
@@ -123,6 +509,42 @@ static void alsaseq_user_client_class_init(ALSASeqUserClientClass *klass)
                            0,
                            G_PARAM_READABLE);
 
+    /**
+     * ALSASeqUserClient:output-queue-size:
+     *
+     * The size of output queue in byte unit. Zero means that the output queue is disabled.
+     */
+    seq_user_client_props[SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_SIZE] =
+        g_param_spec_uint64("output-queue-size", "output-queue-size",
+                            "The size of output queue in byte unit.",
+                            0, G_MAXUINT64,
+                            0,
+                            G_PARAM_READABLE);
+
+    /**
+     * ALSASeqUserClient:output-queue-length:
+     *
+     * The length of events pending in output queue in byte unit.
+     */
+    seq_user_client_props[SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_LENGTH] =
+        g_param_spec_uint64("output-queue-length", "output-queue-length",
+                            "The length of events pending in output queue in byte unit.",
+                            0, G_MAXUINT64,
+                            0,
+                            G_PARAM_READABLE);
+
+    /**
+     * ALSASeqUserClient:output-queue-depth:
+     *
+     * The number of events pending in output queue.
+     */
+    seq_user_client_props[SEQ_USER_CLIENT_PROP_OUTPUT_QUEUE_DEPTH] =
+        g_param_spec_uint64("output-queue-depth", "output-queue-depth",
+                            "The number of events pending in output queue.",
+                            0, G_MAXUINT64,
+                            0,
+                            G_PARAM_READABLE);
+
     g_object_class_install_properties(gobject_class,
                                       SEQ_USER_CLIENT_PROP_COUNT,
                                       seq_user_client_props);
@@ -143,6 +565,122 @@ static void alsaseq_user_client_class_init(ALSASeqUserClientClass *klass)
                      NULL, NULL,
                      g_cclosure_marshal_VOID__BOXED,
                      G_TYPE_NONE, 1, ALSASEQ_TYPE_EVENT_CNTR);
+
+    /**
+     * ALSASeqUserClient::handle-typed-event:
+     * @self: A [class@UserClient].
+     * @event: (transfer none): The instance of [struct@Event].
+     *
+     * When event occurs, this signal is emit for each event in the batch after
+     * [signal@UserClient::handle-event] signal. The signal has detail for the nickname of
+     * [enum@EventType], thus the handler can be connected to the specific type of event, like
+     * `handle-typed-event::noteon`. The emission is skipped for the type of event to which no
+     * handler is connected. For the event with variable length, the blob data is available by
+     * [method@Event.get_blob_data] till the handler returns.
+     */
+    seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_HANDLE_TYPED_EVENT] =
+        g_signal_new("handle-typed-event",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST | G_SIGNAL_DETAILED,
+                     G_STRUCT_OFFSET(ALSASeqUserClientClass, handle_typed_event),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__BOXED,
+                     G_TYPE_NONE, 1, ALSASEQ_TYPE_EVENT | G_SIGNAL_TYPE_STATIC_SCOPE);
+
+    /**
+     * ALSASeqUserClient::flushed:
+     * @self: A [class@UserClient].
+     *
+     * When all of events pending in output queue are written by the source, this signal is emit.
+     */
+    seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_FLUSHED] =
+        g_signal_new("flushed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqUserClientClass, flushed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__VOID,
+                     G_TYPE_NONE, 0, G_TYPE_NONE);
+
+    /**
+     * ALSASeqUserClient::handle-timestamped-event:
+     * @self: A [class@UserClient].
+     * @ev_cntr: (transfer none): The instance of [struct@EventCntr] which includes batch of events.
+     * @timestamp: The value of `CLOCK_MONOTONIC` in nanosecond unit when the batch was read.
+     *
+     * When the batch of events is passed from the reader thread, this signal is emit before
+     * [signal@UserClient::handle-event] signal.
+     */
+    seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_HANDLE_TIMESTAMPED_EVENT] =
+        g_signal_new("handle-timestamped-event",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqUserClientClass, handle_timestamped_event),
+                     NULL, NULL,
+                     g_cclosure_marshal_generic,
+                     G_TYPE_NONE, 2, ALSASEQ_TYPE_EVENT_CNTR, G_TYPE_INT64);
+
+    /**
+     * ALSASeqUserClient::lost-count-changed:
+     * @self: A [class@UserClient].
+     * @lost_count: The current value of [property@ClientInfo:lost-count] for the client.
+     *
+     * When the number of lost events for the client is changed, this signal is emit by the source
+     * created by [method@UserClient.create_pool_watcher_source].
+     */
+    seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_LOST_COUNT_CHANGED] =
+        g_signal_new("lost-count-changed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqUserClientClass, lost_count_changed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__INT,
+                     G_TYPE_NONE, 1, G_TYPE_INT);
+
+    /**
+     * ALSASeqUserClient::barrier-reached:
+     * @self: A [class@UserClient].
+     * @token: The token returned by [method@UserClient.schedule_barrier].
+     *
+     * When the echo event scheduled by [method@UserClient.schedule_barrier] returns to the client,
+     * this signal is emit after [signal@UserClient::handle-event] and
+     * [signal@UserClient::handle-typed-event] signals for the batch including it.
+     */
+    seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_BARRIER_REACHED] =
+        g_signal_new("barrier-reached",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqUserClientClass, barrier_reached),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__UINT,
+                     G_TYPE_NONE, 1, G_TYPE_UINT);
+
+    /**
+     * ALSASeqUserClient::pool-resize-failed:
+     * @self: A [class@UserClient].
+     * @error: A [struct@GLib.Error] with domain of `ALSASeq.UserClientError`.
+     *
+     * When the source created by [method@UserClient.create_pool_watcher_source] fails to resize
+     * the memory pool, this signal is emit.
+     */
+    seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_POOL_RESIZE_FAILED] =
+        g_signal_new("pool-resize-failed",
+                     G_OBJECT_CLASS_TYPE(klass),
+                     G_SIGNAL_RUN_LAST,
+                     G_STRUCT_OFFSET(ALSASeqUserClientClass, pool_resize_failed),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__BOXED,
+                     G_TYPE_NONE, 1, G_TYPE_ERROR);
+
+    enum_class = g_type_class_ref(ALSASEQ_TYPE_EVENT_TYPE);
+    for (i = 0; i < enum_class->n_values; ++i) {
+        const GEnumValue *value = enum_class->values + i;
+
+        if (value->value >= 0 && value->value < G_N_ELEMENTS(seq_user_client_event_type_details))
+            seq_user_client_event_type_details[value->value] =
+                g_quark_from_static_string(value->value_nick);
+    }
+    // The enumeration class is kept so that the nicknames are always available.
 }
 
 static void alsaseq_user_client_init(ALSASeqUserClient *self)
@@ -150,6 +688,14 @@ static void alsaseq_user_client_init(ALSASeqUserClient *self)
     ALSASeqUserClientPrivate *priv =
                                 alsaseq_user_client_get_instance_private(self);
     priv->fd = -1;
+    priv->forward_routes = g_array_new(FALSE, FALSE, sizeof(ALSASeqForwardRoute));
+}
+
+int seq_user_client_get_fd(ALSASeqUserClient *self)
+{
+    ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(self);
+
+    return priv->fd;
 }
 
 /**
@@ -296,6 +842,58 @@ gboolean alsaseq_user_client_set_info(ALSASeqUserClient *self, ALSASeqClientInfo
     return TRUE;
 }
 
+/**
+ * alsaseq_user_client_set_event_filter:
+ * @self: A [class@UserClient].
+ * @event_types: (array length=event_type_count) (nullable): The array with elements for the type
+ *               of event to listen.
+ * @event_type_count: The number of elements for the type of event.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
+ *
+ * Configure the client to listen to the given types of event only, so that the other types of
+ * event are dropped in kernel space without being delivered to user space. When no type of event
+ * is given, the filter is disabled and any type of event is delivered. The other fields of client
+ * information are kept.
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_CLIENT_INFO` and
+ * `SNDRV_SEQ_IOCTL_SET_CLIENT_INFO` commands for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_set_event_filter(ALSASeqUserClient *self,
+                                              const ALSASeqEventType *event_types,
+                                              gsize event_type_count, GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    struct snd_seq_client_info info = {0};
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(event_types != NULL || event_type_count == 0, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    info.client = priv->client_id;
+    if (ioctl(priv->fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, &info) < 0) {
+        generate_syscall_error(error, errno, "ioctl(%s)", "GET_CLIENT_INFO");
+        return FALSE;
+    }
+
+    seq_client_info_fill_event_filter(&info, event_types, event_type_count);
+    if (event_type_count > 0)
+        info.filter |= SNDRV_SEQ_FILTER_USE_EVENT;
+    else
+        info.filter &= ~SNDRV_SEQ_FILTER_USE_EVENT;
+
+    info.type = USER_CLIENT;
+    if (ioctl(priv->fd, SNDRV_SEQ_IOCTL_SET_CLIENT_INFO, &info) < 0) {
+        generate_syscall_error(error, errno, "ioctl(%s)", "SET_CLIENT_INFO");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 /**
  * alsaseq_user_client_get_info:
  * @self: A [class@UserClient].
@@ -543,258 +1141,1452 @@ gboolean alsaseq_user_client_get_pool(ALSASeqUserClient *self,
 }
 
 /**
- * alsaseq_user_client_schedule_event:
+ * alsaseq_user_client_reserve_send_arena:
  * @self: A [class@UserClient].
- * @event: An instance of [struct@Event].
- * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
- *         `ALSASeq.UserClientError`.
+ * @limit: The upper bound of size for the arena in byte unit. Zero means no bound.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
  *
- * Deliver the event immediately, or schedule it into memory pool of the client.
+ * Allocate the arena owned by the client to flatten events before `write(2)` system call. The
+ * size is decided by [property@ClientPool:output-room] of the client, and the arena is reused by
+ * [method@UserClient.schedule_event] and [method@UserClient.schedule_events] so that steady state
+ * of scheduling requires no memory allocation. When the flattened events are larger than the
+ * arena, it grows temporarily and shrinks to the limit after used.
  *
- * The call of function executes `write(2)` system call for ALSA sequencer character device. When
- * [property@ClientPool:output-free] is less than [method@Event.calculate_pool_consumption] and
- * [method@UserClient.open] is called without non-blocking flag, the user process can be blocked
- * untill enough number of cells becomes available.
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_CLIENT_POOL`
+ * command for ALSA sequencer character device.
  *
  * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
  */
-gboolean alsaseq_user_client_schedule_event(ALSASeqUserClient *self, const ALSASeqEvent *event,
-                                            GError **error)
+gboolean alsaseq_user_client_reserve_send_arena(ALSASeqUserClient *self, gsize limit,
+                                                GError **error)
 {
     ALSASeqUserClientPrivate *priv;
-    size_t length;
-    guint8 *buf;
-    ssize_t result;
+    struct snd_seq_client_pool pool = {0};
+    ALSASeqEventCntr *arena;
+    gsize size;
 
     g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
-    g_return_val_if_fail(event != NULL, FALSE);
-    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
-
     priv = alsaseq_user_client_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
 
-    if (!seq_event_is_deliverable(event)) {
-        g_set_error_literal(error, ALSASEQ_USER_CLIENT_ERROR,
-                            ALSASEQ_USER_CLIENT_ERROR_EVENT_UNDELIVERABLE,
-                            "The operation failes due to undeliverable event");
-        return FALSE;
-    }
-
-    length = seq_event_calculate_flattened_length(event, FALSE);
-    if (length == sizeof(*event)) {
-        buf = (guint8 *)event;
-    } else {
-        buf = g_malloc0(length);
-
-        seq_event_copy_flattened(event, buf, length);
-    }
-
-    result = write(priv->fd, buf, length);
-    if (length != sizeof(*event))
-        g_free(buf);
-    if (result < 0) {
-        GFileError code = g_file_error_from_errno(errno);
-
-        if (code != G_FILE_ERROR_FAILED)
-            generate_file_error(error, errno, "write(%s)", priv->devnode);
-        else
-            generate_syscall_error(error, errno, "write(%s)", priv->devnode);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
+    pool.client = priv->client_id;
+    if (ioctl(priv->fd, SNDRV_SEQ_IOCTL_GET_CLIENT_POOL, &pool) < 0) {
+        generate_syscall_error(error, errno, "ioctl(%s)", "GET_CLIENT_POOL");
         return FALSE;
     }
 
-    g_return_val_if_fail(result == length, FALSE);
+    // The cell in the pool has the same size as the event.
+    size = (gsize)MAX(pool.output_room, 1) * sizeof(struct snd_seq_event);
+    if (limit > 0)
+        size = MIN(size, limit);
+
+    arena = &priv->send_arena;
+    arena->buf = g_realloc(arena->buf, size);
+    arena->length = 0;
+    arena->capacity = size;
+    priv->send_arena_limit = limit;
 
     return TRUE;
 }
 
 /**
- * alsaseq_user_client_schedule_events:
+ * alsaseq_user_client_set_output_queue_size:
  * @self: A [class@UserClient].
- * @events: (element-type ALSASeq.Event) (transfer none): The list of [struct@Event].
- * @count: (out): The number of events to be scheduled.
- * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
- *         `ALSASeq.UserClientError`.
+ * @size: The size of output queue in byte unit. Zero means to disable the queue.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
  *
- * Deliver the events immediately, or schedule it into memory pool of the client.
+ * Configure the output queue owned by the client. When [method@UserClient.open] is called with
+ * non-blocking flag and the memory pool of the client has no room, the events which can not be
+ * written are queued instead of failure of [method@UserClient.schedule_event],
+ * [method@UserClient.schedule_events], and [method@UserClient.schedule_event_cntr]. The queued
+ * events are flushed by the source created by [method@UserClient.create_source] when the room
+ * becomes available, then [signal@UserClient::flushed] signal is emitted.
  *
- * The call of function executes `write(2)` system call for ALSA sequencer character device. When
- * [property@ClientPool:output-free] is less than sum of [method@Event.calculate_pool_consumption]
- * and [method@UserClient.open] is called without non-blocking flag, the user process can be
- * blocked untill enough number of cells becomes available.
+ * When `write(2)` fails to flush the queue due to the other reason than `EAGAIN`, for example
+ * `ENOENT` after the destination client exits, the event at the head of queue is dropped and
+ * counted in [struct@UserClientStats], then the rest of events are flushed continuously.
+ *
+ * The size can not be less than [property@UserClient:output-queue-length].
  *
  * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
  */
-gboolean alsaseq_user_client_schedule_events(ALSASeqUserClient *self, const GList *events,
-                                             gsize *count, GError **error)
+gboolean alsaseq_user_client_set_output_queue_size(ALSASeqUserClient *self, gsize size,
+                                                   GError **error)
 {
     ALSASeqUserClientPrivate *priv;
-    ALSASeqEventCntr cntr = { 0 };
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (size < priv->output_queue_length) {
+        g_set_error(error, ALSASEQ_USER_CLIENT_ERROR, ALSASEQ_USER_CLIENT_ERROR_FAILED,
+                    "The size is less than the length of pending events: %lu", size);
+        return FALSE;
+    }
+
+    if (size > 0) {
+        priv->output_queue = g_realloc(priv->output_queue, size);
+    } else {
+        g_free(priv->output_queue);
+        priv->output_queue = NULL;
+    }
+    priv->output_queue_size = size;
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_user_client_set_pointer_data_threshold:
+ * @self: A [class@UserClient].
+ * @threshold: The minimum length of blob data to be delivered by pointer, in byte unit. Zero
+ *             means to disable it.
+ *
+ * Configure the delivery of blob data by pointer. When the event of
+ * [enum@EventLengthMode].VARIABLE is delivered directly by [method@UserClient.schedule_event] and
+ * [method@UserClient.schedule_events] and the length of blob data is not less than the threshold,
+ * the event is written as [enum@EventLengthMode].VARUSR pointing to the blob data, instead of
+ * copying the blob data into the flattened buffer. ALSA Sequencer core reads the blob data from
+ * user space during the call of `write(2)`. The configuration is ignored while the output queue
+ * is enabled by [method@UserClient.set_output_queue_size], since the queued events are written
+ * later.
+ *
+ * ALSA Sequencer core copies the blob data just for the destination of kernel client, while the
+ * destination of user client receives the pointer itself. The event is therefore converted only
+ * when the destination is kernel client, and never when the destination is
+ * [enum@SpecificAddress].SUBSCRIBERS nor [enum@SpecificAddress].BROADCAST. The type of
+ * destination client is checked by `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_CLIENT_INFO`
+ * command once in each call of the schedule functions.
+ */
+void alsaseq_user_client_set_pointer_data_threshold(ALSASeqUserClient *self, gsize threshold)
+{
+    ALSASeqUserClientPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_USER_CLIENT(self));
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    priv->pointer_data_threshold = threshold;
+}
+
+/**
+ * alsaseq_user_client_set_coalescing_window:
+ * @self: A [class@UserClient].
+ * @window: The maximum number of events pending in the output queue between the events to be
+ *          coalesced. Zero means to disable coalescing.
+ *
+ * Configure coalescing of events in the output queue enabled by
+ * [method@UserClient.set_output_queue_size]. When the events of [enum@EventType].CONTROLLER,
+ * [enum@EventType].PITCHBEND, and [enum@EventType].CHANPRESS are queued to be delivered directly,
+ * the former event pending in the queue with the same destination, source port, channel, and
+ * parameter within the window is overwritten by the value of the latter event, then the latter
+ * event is dropped. The other events are passed through exactly without re-ordering. The
+ * coalescing is done inside the flattened buffer of output queue, thus it saves cells in the
+ * memory pool for the slow destination only when the events are pending.
+ *
+ * The events are coalesced just when no other event for the same destination and channel is
+ * queued between them, so that the value is not moved across the other events for the channel;
+ * e.g. notes between the changes of volume. The events of [enum@EventType].SYSEX,
+ * [enum@EventType].RESET, and the events with variable length of data are regarded as the events
+ * for all of channels. The controllers with state or meaning in the sequence are not coalesced;
+ * bank select (0, 32), data entry (6, 38), switches (64-69), data increment/decrement and
+ * NRPN/RPN (96-101), and channel mode messages (120-127).
+ */
+void alsaseq_user_client_set_coalescing_window(ALSASeqUserClient *self, guint window)
+{
+    ALSASeqUserClientPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_USER_CLIENT(self));
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    if (window > 0 && priv->coalescing_slots == NULL) {
+        priv->coalescing_slots = g_new0(CoalescingSlot, COALESCING_SLOT_COUNT);
+        priv->coalescing_channels = g_new0(CoalescingChannel, COALESCING_SLOT_COUNT);
+    }
+
+    priv->coalescing_window = window;
+    seq_user_client_invalidate_coalescing(priv);
+}
+
+/**
+ * alsaseq_user_client_add_forward_route:
+ * @self: A [class@UserClient].
+ * @route: A [struct@ForwardRoute].
+ *
+ * Add the route to forward events received by the client. After the handlers of
+ * [signal@UserClient::handle-event] and [signal@UserClient::handle-typed-event] signals, the events
+ * matched to any route are rewritten in place inside the received buffer, then delivered to
+ * destination by single `write(2)` system call per read. The port which received the event is
+ * used as the source of forwarded event, and the event is delivered directly without queue. The
+ * routes are evaluated in the order of addition, and the first matched route is used. The events
+ * matched to no route are not forwarded. The events which fail to be written are counted in
+ * [struct@UserClientStats].
+ */
+void alsaseq_user_client_add_forward_route(ALSASeqUserClient *self,
+                                           const ALSASeqForwardRoute *route)
+{
+    ALSASeqUserClientPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_USER_CLIENT(self));
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_if_fail(route != NULL);
+
+    g_array_append_val(priv->forward_routes, *route);
+}
+
+/**
+ * alsaseq_user_client_clear_forward_routes:
+ * @self: A [class@UserClient].
+ *
+ * Remove all of routes to forward events.
+ */
+void alsaseq_user_client_clear_forward_routes(ALSASeqUserClient *self)
+{
+    ALSASeqUserClientPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_USER_CLIENT(self));
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_array_set_size(priv->forward_routes, 0);
+}
+
+/**
+ * alsaseq_user_client_get_stats:
+ * @self: A [class@UserClient].
+ * @stats: (out caller-allocates): A [struct@UserClientStats] to store the snapshot of counters.
+ *
+ * Get the snapshot of counters for throughput and batching of events. The counters for reading
+ * are updated when the events are dispatched by any source created by the client, and the
+ * counters for writing are updated by the calls of schedule functions and the flush of output
+ * queue. The call is available in any thread.
+ */
+void alsaseq_user_client_get_stats(ALSASeqUserClient *self, ALSASeqUserClientStats *stats)
+{
+    ALSASeqUserClientPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_USER_CLIENT(self));
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_if_fail(stats != NULL);
+
+    stats->events_read = stats_load(priv, events_read);
+    stats->bytes_read = stats_load(priv, bytes_read);
+    stats->read_calls = stats_load(priv, read_calls);
+    stats->dispatches = stats_load(priv, dispatches);
+    stats->max_batch = stats_load(priv, max_batch);
+    stats->events_written = stats_load(priv, events_written);
+    stats->bytes_written = stats_load(priv, bytes_written);
+    stats->write_calls = stats_load(priv, write_calls);
+    stats->eagain_count = stats_load(priv, eagain_count);
+    stats->enomem_count = stats_load(priv, enomem_count);
+    stats->handler_time = stats_load(priv, handler_time);
+    stats->events_coalesced = stats_load(priv, events_coalesced);
+    stats->events_dropped = stats_load(priv, events_dropped);
+    stats->events_unforwarded = stats_load(priv, events_unforwarded);
+}
+
+/**
+ * alsaseq_user_client_reset_stats:
+ * @self: A [class@UserClient].
+ *
+ * Reset all of counters for throughput and batching of events.
+ */
+void alsaseq_user_client_reset_stats(ALSASeqUserClient *self)
+{
+    ALSASeqUserClientPrivate *priv;
+
+    g_return_if_fail(ALSASEQ_IS_USER_CLIENT(self));
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    stats_store(priv, events_read, 0);
+    stats_store(priv, bytes_read, 0);
+    stats_store(priv, read_calls, 0);
+    stats_store(priv, dispatches, 0);
+    stats_store(priv, max_batch, 0);
+    stats_store(priv, events_written, 0);
+    stats_store(priv, bytes_written, 0);
+    stats_store(priv, write_calls, 0);
+    stats_store(priv, eagain_count, 0);
+    stats_store(priv, enomem_count, 0);
+    stats_store(priv, handler_time, 0);
+    stats_store(priv, events_coalesced, 0);
+    stats_store(priv, events_dropped, 0);
+    stats_store(priv, events_unforwarded, 0);
+}
+
+/**
+ * alsaseq_user_client_schedule_event:
+ * @self: A [class@UserClient].
+ * @event: An instance of [struct@Event].
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Deliver the event immediately, or schedule it into memory pool of the client.
+ *
+ * The call of function executes `write(2)` system call for ALSA sequencer character device. When
+ * [property@ClientPool:output-free] is less than [method@Event.calculate_pool_consumption] and
+ * [method@UserClient.open] is called without non-blocking flag, the user process can be blocked
+ * untill enough number of cells becomes available.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_schedule_event(ALSASeqUserClient *self, const ALSASeqEvent *event,
+                                            GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    PointerDataContext ctx = { 0 };
+    struct snd_seq_event header;
+    size_t length;
+    const guint8 *buf;
+    gsize written;
+    gboolean result;
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    g_return_val_if_fail(event != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    if (!seq_event_is_deliverable(event)) {
+        g_set_error_literal(error, ALSASEQ_USER_CLIENT_ERROR,
+                            ALSASEQ_USER_CLIENT_ERROR_EVENT_UNDELIVERABLE,
+                            "The operation failes due to undeliverable event");
+        return FALSE;
+    }
+
+    ctx.fd = priv->fd;
+    ctx.threshold = seq_user_client_get_pointer_data_threshold(priv);
+    if (seq_user_client_deliver_by_pointer(event, &ctx)) {
+        header = *event;
+        header.flags &= ~SNDRV_SEQ_EVENT_LENGTH_MASK;
+        header.flags |= SNDRV_SEQ_EVENT_LENGTH_VARUSR;
+        length = sizeof(header);
+        buf = (const guint8 *)&header;
+    } else {
+        length = seq_event_calculate_flattened_length(event, FALSE);
+        if (length == sizeof(*event)) {
+            buf = (const guint8 *)event;
+        } else {
+            GList entry = { .data = (gpointer)event, };
+
+            seq_event_cntr_serialize(&priv->send_arena, &entry, FALSE, NULL, NULL);
+            buf = priv->send_arena.buf;
+        }
+    }
+
+    result = seq_user_client_write(priv, buf, length, &written, error);
+    if (length != sizeof(*event))
+        seq_user_client_release_send_arena(priv);
+    if (!result)
+        return FALSE;
+
+    g_return_val_if_fail(written == length, FALSE);
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_user_client_schedule_events:
+ * @self: A [class@UserClient].
+ * @events: (element-type ALSASeq.Event) (transfer none): The list of [struct@Event].
+ * @count: (out): The number of events to be scheduled.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Deliver the events immediately, or schedule it into memory pool of the client.
+ *
+ * The call of function executes `write(2)` system call for ALSA sequencer character device. When
+ * [property@ClientPool:output-free] is less than sum of [method@Event.calculate_pool_consumption]
+ * and [method@UserClient.open] is called without non-blocking flag, the user process can be
+ * blocked untill enough number of cells becomes available.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_schedule_events(ALSASeqUserClient *self, const GList *events,
+                                             gsize *count, GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    PointerDataContext ctx = { 0 };
     const GList *entry;
     gsize index;
-    gsize pos;
+    gsize written;
+    gboolean result;
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    index = 0;
+    for (entry = events; entry != NULL; entry = g_list_next(entry)) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)entry->data;
+
+        g_return_val_if_fail(ev != NULL, FALSE);
+        if (!seq_event_is_deliverable(ev)) {
+            g_set_error(error, ALSASEQ_USER_CLIENT_ERROR,
+                        ALSASEQ_USER_CLIENT_ERROR_EVENT_UNDELIVERABLE,
+                        "The operation failes due to undeliverable event: index %lu",
+                        index);
+            return FALSE;
+        }
+        ++index;
+    }
+
+    // Nothing to do.
+    if (events == NULL) {
+        *count = 0;
+        return TRUE;
+    }
+
+    ctx.fd = priv->fd;
+    ctx.threshold = seq_user_client_get_pointer_data_threshold(priv);
+    seq_event_cntr_serialize(&priv->send_arena, events, FALSE,
+                             ctx.threshold > 0 ? seq_user_client_deliver_by_pointer : NULL, &ctx);
+
+    result = seq_user_client_write(priv, priv->send_arena.buf, priv->send_arena.length, &written,
+                                   error);
+    if (result)
+        *count = seq_user_client_count_events(priv->send_arena.buf, written);
+    seq_user_client_release_send_arena(priv);
+
+    return result;
+}
+
+/**
+ * alsaseq_user_client_schedule_event_cntr:
+ * @self: A [class@UserClient].
+ * @ev_cntr: A [struct@EventCntr] composed by the append functions.
+ * @count: (out): The number of events to be scheduled.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Deliver the batch of events in the container immediately, or schedule it into memory pool of
+ * the client. The events are validated when appended to the container, thus the flattened buffer
+ * is passed to the system call as is.
+ *
+ * The call of function executes `write(2)` system call for ALSA sequencer character device. When
+ * [property@ClientPool:output-free] is less than sum of [method@Event.calculate_pool_consumption]
+ * and [method@UserClient.open] is called without non-blocking flag, the user process can be
+ * blocked untill enough number of cells becomes available.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_schedule_event_cntr(ALSASeqUserClient *self,
+                                                 const ALSASeqEventCntr *ev_cntr, gsize *count,
+                                                 GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    gsize written;
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(ev_cntr != NULL, FALSE);
+    g_return_val_if_fail(!ev_cntr->aligned, FALSE);
+    g_return_val_if_fail(count != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    // Nothing to do.
+    if (ev_cntr->length == 0) {
+        *count = 0;
+        return TRUE;
+    }
+
+    if (!seq_user_client_write(priv, ev_cntr->buf, ev_cntr->length, &written, error))
+        return FALSE;
+
+    *count = seq_user_client_count_events(ev_cntr->buf, written);
+
+    return TRUE;
+}
+
+/**
+ * alsaseq_user_client_schedule_barrier:
+ * @self: A [class@UserClient].
+ * @port_id: The numeric ID of port in the client to receive the echo event.
+ * @last_event: (nullable): The last event of scheduled events to wait for, or %NULL to wait for
+ *              the events delivered immediately.
+ * @token: (out): The token to identify the barrier in [signal@UserClient::barrier-reached] signal.
+ * @error: A [struct@GLib.Error]. Error is generated with two domains; `GLib.FileError` and
+ *         `ALSASeq.UserClientError`.
+ *
+ * Schedule the echo event to the port of client itself behind the events scheduled so far. The
+ * echo event is scheduled in the same queue at the same time as the given event, thus it is
+ * delivered after the event since ALSA Sequencer core keeps the order of events at the same time.
+ * When the echo event returns to the client, [signal@UserClient::barrier-reached] signal is emit
+ * with the token, thus the source of client should be attached to [struct@GLib.MainContext].
+ *
+ * The call of function executes `write(2)` system call for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_schedule_barrier(ALSASeqUserClient *self, guint8 port_id,
+                                              const ALSASeqEvent *last_event, guint *token,
+                                              GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    struct snd_seq_event ev = { 0 };
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(token != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (last_event != NULL) {
+        ev.flags = last_event->flags & (SNDRV_SEQ_TIME_STAMP_MASK | SNDRV_SEQ_TIME_MODE_MASK);
+        ev.queue = last_event->queue;
+        ev.time = last_event->time;
+    } else {
+        ev.queue = SNDRV_SEQ_QUEUE_DIRECT;
+    }
+    ev.type = SNDRV_SEQ_EVENT_ECHO;
+    ev.source.port = port_id;
+    ev.dest.client = priv->client_id;
+    ev.dest.port = port_id;
+
+    // The token is not zero so that the event is distinguishable.
+    if (++priv->barrier_token == 0)
+        ++priv->barrier_token;
+    ev.data.raw32.d[0] = SEQ_BARRIER_MAGIC;
+    ev.data.raw32.d[1] = priv->barrier_token;
+
+    // The counter is referred by the dispatcher to check echo events in the batch.
+    __atomic_add_fetch(&priv->pending_barriers, 1, __ATOMIC_RELEASE);
+
+    if (!alsaseq_user_client_schedule_event(self, &ev, error)) {
+        __atomic_sub_fetch(&priv->pending_barriers, 1, __ATOMIC_RELEASE);
+        return FALSE;
+    }
+
+    *token = priv->barrier_token;
+
+    return TRUE;
+}
+
+static void seq_user_client_emit_barriers(ALSASeqUserClient *self,
+                                          const ALSASeqEventCntr *ev_cntr)
+{
+    ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(self);
+    gsize pos = 0;
+
+    while (pos + sizeof(struct snd_seq_event) <= ev_cntr->length) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)(ev_cntr->buf + pos);
+
+        if (ev->type == SNDRV_SEQ_EVENT_ECHO && ev->source.client == priv->client_id &&
+            ev->data.raw32.d[0] == SEQ_BARRIER_MAGIC && ev->data.raw32.d[1] != 0) {
+            __atomic_sub_fetch(&priv->pending_barriers, 1, __ATOMIC_RELEASE);
+            g_signal_emit(self, seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_BARRIER_REACHED], 0,
+                          ev->data.raw32.d[1]);
+        }
+
+        pos += seq_event_calculate_flattened_length(ev, ev_cntr->aligned);
+    }
+}
+
+static gboolean seq_user_client_prepare_src(GSource *gsrc, gint *timeout)
+{
+    UserClientSource *src = (UserClientSource *)gsrc;
+    ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(src->self);
+    GIOCondition events;
+
+    // Poll for room in the pool only when any event is pending in output queue.
+    events = G_IO_IN;
+    if (priv->output_queue_length > 0)
+        events |= G_IO_OUT;
+
+    if (events != src->events) {
+        g_source_modify_unix_fd(gsrc, src->tag, events);
+        src->events = events;
+    }
+
+    *timeout = -1;
+
+    return FALSE;
+}
+
+static gboolean seq_user_client_check_src(GSource *gsrc)
+{
+    UserClientSource *src = (UserClientSource *)gsrc;
+    GIOCondition condition;
+
+    // Don't go to dispatch if nothing available. As an exception, return TRUE
+    // for POLLERR to call .dispatch for internal destruction.
+    condition = g_source_query_unix_fd(gsrc, src->tag);
+    return !!(condition & (G_IO_IN | G_IO_OUT | G_IO_ERR));
+}
+
+// Flush the events pending in output queue. When the write fails due to the other reason than
+// EAGAIN, the event at the head of queue is dropped so that the rest of events are not blocked
+// by it; e.g. ENOENT after the destination client exits.
+static void seq_user_client_flush_output_queue(ALSASeqUserClient *self)
+{
+    ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(self);
     ssize_t result;
-    gsize scheduled;
+    gsize count;
+
+    if (priv->output_queue_length == 0)
+        return;
+
+    result = write(priv->fd, priv->output_queue, priv->output_queue_length);
+    if (result < 0) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)priv->output_queue;
+
+        seq_user_client_count_write_error(priv, errno);
+        if (errno == EAGAIN)
+            return;
+
+        result = seq_event_calculate_flattened_length(ev, FALSE);
+        count = 1;
+        stats_add(priv, events_dropped, 1);
+    } else {
+        count = seq_user_client_count_events(priv->output_queue, result);
+        seq_user_client_count_written(priv, result, count);
+    }
+
+    priv->output_queue_depth -= count;
+    priv->output_queue_length -= result;
+    memmove(priv->output_queue, priv->output_queue + result, priv->output_queue_length);
+    seq_user_client_invalidate_coalescing(priv);
+
+    if (priv->output_queue_length == 0)
+        g_signal_emit(self, seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_FLUSHED], 0);
+}
+
+static void seq_user_client_emit_typed_events(ALSASeqUserClient *self,
+                                              const ALSASeqEventCntr *ev_cntr)
+{
+    ALSASeqUserClientClass *klass = ALSASEQ_USER_CLIENT_GET_CLASS(self);
+    guint sig = seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_HANDLE_TYPED_EVENT];
+    gsize pos;
+
+    // Nothing to do when neither handler nor class closure is available.
+    if (klass->handle_typed_event == NULL && !g_signal_has_handler_pending(self, sig, 0, FALSE))
+        return;
+
+    pos = 0;
+    while (pos + sizeof(struct snd_seq_event) <= ev_cntr->length) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)(ev_cntr->buf + pos);
+        GQuark detail = seq_user_client_event_type_details[ev->type];
+
+        if (klass->handle_typed_event != NULL ||
+            g_signal_has_handler_pending(self, sig, detail, FALSE)) {
+            if ((ev->flags & SNDRV_SEQ_EVENT_LENGTH_MASK) == SNDRV_SEQ_EVENT_LENGTH_VARIABLE) {
+                struct snd_seq_event tmp = *ev;
+
+                // The pointer in the event is the one in kernel space. Patch it to point to the
+                // blob which follows the event in the flattened layout.
+                tmp.data.ext.ptr = (void *)(ev + 1);
+                g_signal_emit(self, sig, detail, &tmp);
+            } else {
+                g_signal_emit(self, sig, detail, ev);
+            }
+        }
+
+        pos += seq_event_calculate_flattened_length(ev, ev_cntr->aligned);
+    }
+}
+
+static const ALSASeqForwardRoute *
+seq_user_client_match_forward_route(ALSASeqUserClientPrivate *priv, const struct snd_seq_event *ev)
+{
+    guint i;
+
+    for (i = 0; i < priv->forward_routes->len; ++i) {
+        const ALSASeqForwardRoute *route =
+                &g_array_index(priv->forward_routes, ALSASeqForwardRoute, i);
+
+        if (ev->source.client != route->source.client || ev->source.port != route->source.port)
+            continue;
+
+        if (!route->any_event_type &&
+            !(route->event_types[ev->type / 32] & (1u << (ev->type % 32))))
+            continue;
+
+        if (route->channel >= 0) {
+            if (ev->type >= SNDRV_SEQ_EVENT_NOTE && ev->type <= SNDRV_SEQ_EVENT_KEYPRESS) {
+                if (ev->data.note.channel != route->channel)
+                    continue;
+            } else if (ev->type >= SNDRV_SEQ_EVENT_CONTROLLER &&
+                       ev->type <= SNDRV_SEQ_EVENT_REGPARAM) {
+                if (ev->data.control.channel != route->channel)
+                    continue;
+            }
+        }
+
+        return route;
+    }
+
+    return NULL;
+}
+
+static void seq_user_client_transform_event(const ALSASeqForwardRoute *route,
+                                            struct snd_seq_event *ev)
+{
+    if (ev->type >= SNDRV_SEQ_EVENT_NOTE && ev->type <= SNDRV_SEQ_EVENT_KEYPRESS) {
+        struct snd_seq_ev_note *note = &ev->data.note;
+
+        if (route->channel_remap >= 0)
+            note->channel = route->channel_remap;
+        if (route->transpose != 0)
+            note->note = CLAMP((gint)note->note + route->transpose, 0, 127);
+        if (route->has_velocity_curve && ev->type != SNDRV_SEQ_EVENT_KEYPRESS &&
+            note->velocity > 0 && note->velocity < G_N_ELEMENTS(route->velocity_curve))
+            note->velocity = route->velocity_curve[note->velocity];
+    } else if (ev->type >= SNDRV_SEQ_EVENT_CONTROLLER && ev->type <= SNDRV_SEQ_EVENT_REGPARAM) {
+        if (route->channel_remap >= 0)
+            ev->data.control.channel = route->channel_remap;
+    }
+
+    ev->dest = route->destination;
+    ev->queue = SNDRV_SEQ_QUEUE_DIRECT;
+}
+
+// Rewrite the events matched to any route in place, then compact them into the unaligned layout
+// for write(2). The first matched route is used for each event.
+static void seq_user_client_forward_events(ALSASeqUserClientPrivate *priv, guint8 *buf,
+                                           gsize length)
+{
+    gsize pos = 0;
+    gsize filled = 0;
+
+    while (pos + sizeof(struct snd_seq_event) <= length) {
+        struct snd_seq_event *ev = (struct snd_seq_event *)(buf + pos);
+        gsize ev_length = seq_event_calculate_flattened_length(ev, FALSE);
+        gsize aligned_length = seq_event_calculate_flattened_length(ev, TRUE);
+        const ALSASeqForwardRoute *route = seq_user_client_match_forward_route(priv, ev);
+
+        if (route != NULL) {
+            // The port which received the event is used to deliver.
+            ev->source.port = ev->dest.port;
+            seq_user_client_transform_event(route, ev);
+
+            if (filled != pos)
+                memmove(buf + filled, buf + pos, ev_length);
+            filled += ev_length;
+        }
+
+        pos += aligned_length;
+    }
+
+    if (filled > 0) {
+        GError *error = NULL;
+        gsize written;
+
+        // The events not written are counted in the statistics since nothing can be done in the
+        // dispatcher.
+        if (!seq_user_client_write(priv, buf, filled, &written, &error)) {
+            g_error_free(error);
+            written = 0;
+        }
+        if (written < filled) {
+            stats_add(priv, events_unforwarded,
+                      seq_user_client_count_events(buf + written, filled - written));
+        }
+    }
+}
+
+// Start, stop, or continue the queue by the event delivered to the system timer port directly.
+gboolean seq_user_client_control_queue(ALSASeqUserClient *self, guint8 queue_id,
+                                       guint8 event_type, GError **error)
+{
+    struct snd_seq_event ev = {0};
+
+    ev.type = event_type;
+    ev.flags = SNDRV_SEQ_TIME_STAMP_TICK | SNDRV_SEQ_TIME_MODE_REL | SNDRV_SEQ_EVENT_LENGTH_FIXED;
+    ev.queue = SNDRV_SEQ_QUEUE_DIRECT;
+    ev.dest.client = SNDRV_SEQ_CLIENT_SYSTEM;
+    ev.dest.port = SNDRV_SEQ_PORT_SYSTEM_TIMER;
+    ev.data.queue.queue = queue_id;
+
+    return alsaseq_user_client_schedule_event(self, &ev, error);
+}
+
+// Emit the signals for the batch of events read from the character device.
+void seq_user_client_emit_event_cntr(ALSASeqUserClient *self, const ALSASeqEventCntr *ev_cntr)
+{
+    ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(self);
+    struct timespec begin, end;
+    gsize pos = 0;
+    gsize count = 0;
+
+    while (pos + sizeof(struct snd_seq_event) <= ev_cntr->length) {
+        const struct snd_seq_event *ev = (const struct snd_seq_event *)(ev_cntr->buf + pos);
+
+        pos += seq_event_calculate_flattened_length(ev, ev_cntr->aligned);
+        ++count;
+    }
+
+    stats_add(priv, read_calls, 1);
+    stats_add(priv, bytes_read, ev_cntr->length);
+    stats_add(priv, events_read, count);
+    seq_user_client_update_max_batch(priv, count);
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+
+    g_signal_emit(self, seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_HANDLE_EVENT], 0, ev_cntr);
+
+    seq_user_client_emit_typed_events(self, ev_cntr);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    stats_add(priv, handler_time,
+              (end.tv_sec - begin.tv_sec) * G_GINT64_CONSTANT(1000000000) +
+              (end.tv_nsec - begin.tv_nsec));
+
+    if (__atomic_load_n(&priv->pending_barriers, __ATOMIC_ACQUIRE) > 0)
+        seq_user_client_emit_barriers(self, ev_cntr);
+
+    // The handlers receive the events as is, then they are rewritten for forwarding.
+    if (priv->forward_routes->len > 0 && ev_cntr->aligned)
+        seq_user_client_forward_events(priv, ev_cntr->buf, ev_cntr->length);
+}
+
+static gboolean seq_user_client_dispatch_src(GSource *gsrc, GSourceFunc cb,
+                                             gpointer user_data)
+{
+    UserClientSource *src = (UserClientSource *)gsrc;
+    ALSASeqUserClient *self = src->self;
+    ALSASeqUserClientPrivate *priv;
+    GIOCondition condition;
+    guint count;
+
+    priv = alsaseq_user_client_get_instance_private(self);
+    if (priv->fd < 0)
+        return G_SOURCE_REMOVE;
+
+    condition = g_source_query_unix_fd(gsrc, src->tag);
+    if (condition & G_IO_ERR)
+        return G_SOURCE_REMOVE;
+
+    if (condition & G_IO_OUT)
+        seq_user_client_flush_output_queue(self);
+
+    if (!(condition & G_IO_IN))
+        return G_SOURCE_CONTINUE;
+
+    stats_add(priv, dispatches, 1);
+
+    // Drain the file descriptor till EAGAIN or the budget of read(2) runs out.
+    for (count = 0; count < src->max_reads; ++count) {
+        ALSASeqEventCntr ev_cntr = { 0 };
+        int len;
+
+        len = read(priv->fd, src->buf, src->buf_len);
+        if (len < 0) {
+            if (errno == EAGAIN)
+                break;
+
+            return G_SOURCE_REMOVE;
+        }
+
+        // NOTE: The buffer is flatten layout.
+        ev_cntr.buf = src->buf;
+        ev_cntr.length = len;
+        ev_cntr.aligned = TRUE;
+
+        seq_user_client_emit_event_cntr(self, &ev_cntr);
+    }
+
+    // Just be sure to continue to process this source.
+    return G_SOURCE_CONTINUE;
+}
+
+static void seq_user_client_finalize_src(GSource *gsrc)
+{
+    UserClientSource *src = (UserClientSource *)gsrc;
+
+    g_free(src->buf);
+    g_object_unref(src->self);
+}
+
+/**
+ * alsaseq_user_client_create_source:
+ * @self: A [class@UserClient].
+ * @gsrc: (out): A #GSource to handle events from ALSA seq character device.
+ * @error: A [struct@GLib.Error].
+ *
+ * Allocate [struct@GLib.Source] structure to handle events from ALSA seq character device. In each
+ * iteration of [struct@GLib.MainContext], the `read(2)` system call is exected to dispatch
+ * sequencer event for [signal@UserClient::handle-event] signal, according to the result of
+ * `poll(2)` system call.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_create_source(ALSASeqUserClient *self, GSource **gsrc, GError **error)
+{
+    return alsaseq_user_client_create_source_full(self, 0, 1, gsrc, error);
+}
+
+/**
+ * alsaseq_user_client_create_source_full:
+ * @self: A [class@UserClient].
+ * @buffer_size: The size of buffer to receive events in byte unit. Zero means the size of page.
+ * @max_reads: The maximum number of `read(2)` system call in each dispatch.
+ * @gsrc: (out): A #GSource to handle events from ALSA seq character device.
+ * @error: A [struct@GLib.Error].
+ *
+ * Allocate [struct@GLib.Source] structure to handle events from ALSA seq character device, as
+ * well as [method@UserClient.create_source]. In each iteration of [struct@GLib.MainContext], the
+ * `read(2)` system call is executed repeatedly till it fails with `EAGAIN` or the number of calls
+ * reaches the maximum, then [signal@UserClient::handle-event] signal is emitted for each of the
+ * calls. The larger buffer is useful for variable length of event with large blob data.
+ *
+ * When [method@UserClient.open] is called without non-blocking flag, the `read(2)` system call
+ * is executed just once in each dispatch, since the second call can block the user process.
+ *
+ * When any event is pending in the output queue enabled by
+ * [method@UserClient.set_output_queue_size], the source polls the room in memory pool of the
+ * client as well, then executes `write(2)` system call to flush the queue.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_create_source_full(ALSASeqUserClient *self, gsize buffer_size,
+                                                guint max_reads, GSource **gsrc, GError **error)
+{
+    static GSourceFuncs funcs = {
+            .prepare        = seq_user_client_prepare_src,
+            .check          = seq_user_client_check_src,
+            .dispatch       = seq_user_client_dispatch_src,
+            .finalize       = seq_user_client_finalize_src,
+    };
+    ALSASeqUserClientPrivate *priv;
+    UserClientSource *src;
+    void *buf;
+    int flags;
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+    g_return_val_if_fail(priv->fd >= 0, FALSE);
+
+    g_return_val_if_fail(buffer_size == 0 || buffer_size >= sizeof(struct snd_seq_event), FALSE);
+    g_return_val_if_fail(max_reads > 0, FALSE);
+    g_return_val_if_fail(gsrc != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    flags = fcntl(priv->fd, F_GETFL);
+    if (flags < 0) {
+        generate_syscall_error(error, errno, "fcntl(%s)", "F_GETFL");
+        return FALSE;
+    }
+    if (!(flags & O_NONBLOCK))
+        max_reads = 1;
+
+    if (buffer_size == 0)
+        buffer_size = sysconf(_SC_PAGESIZE);
+
+    buf = g_malloc0(buffer_size);
+
+    *gsrc = g_source_new(&funcs, sizeof(*src));
+    src = (UserClientSource *)(*gsrc);
+
+    g_source_set_name(*gsrc, "ALSASeqUserClient");
+    g_source_set_priority(*gsrc, G_PRIORITY_HIGH_IDLE);
+    g_source_set_can_recurse(*gsrc, TRUE);
+
+    src->self = g_object_ref(self);
+    src->tag = g_source_add_unix_fd(*gsrc, priv->fd, G_IO_IN);
+    src->events = G_IO_IN;
+    src->buf = buf;
+    src->buf_len = buffer_size;
+    src->max_reads = max_reads;
+
+    return TRUE;
+}
 
-    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
-    priv = alsaseq_user_client_get_instance_private(self);
+typedef struct {
+    gint64 timestamp;
+    gsize length;
+    guint8 *buf;
+} ReaderSlot;
 
-    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+typedef struct {
+    GSource src;
+    ALSASeqUserClient *self;
+    gpointer tag;
+    int wake_fd;
+    int space_fd;
+    int stop_fd;
+    pthread_t thread;
+    gboolean thread_started;
+    ReaderSlot *slots;
+    guint slot_count;
+    guint8 *bufs;
+    gsize buf_len;
+    // The single-producer/single-consumer ring. The head is moved by the reader thread, and the
+    // tail is moved by the thread running the context.
+    guint head;
+    guint tail;
+    guint producer_waiting;
+    guint terminated;
+    ALSASeqUserClientReaderFunc func;
+    gpointer user_data;
+    GDestroyNotify destroy;
+} UserClientReaderSource;
+
+static void *seq_user_client_reader_thread(void *arg)
+{
+    UserClientReaderSource *src = (UserClientReaderSource *)arg;
+    ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(src->self);
+    struct pollfd pfds[2];
+
+    pfds[0].fd = src->stop_fd;
+    pfds[0].events = POLLIN;
+
+    while (TRUE) {
+        guint head = g_atomic_int_get((gint *)&src->head);
+        guint tail = g_atomic_int_get((gint *)&src->tail);
+        gboolean full = head - tail >= src->slot_count;
+        ReaderSlot *slot;
+        struct timespec ts;
+        ssize_t len;
+
+        if (full) {
+            // Check again after the flag to avoid lost wakeup.
+            g_atomic_int_set((gint *)&src->producer_waiting, 1);
+            tail = g_atomic_int_get((gint *)&src->tail);
+            full = head - tail >= src->slot_count;
+        }
 
-    index = 0;
-    for (entry = events; entry != NULL; entry = g_list_next(entry)) {
-        const struct snd_seq_event *ev = (const struct snd_seq_event *)entry->data;
+        pfds[1].fd = full ? src->space_fd : priv->fd;
+        pfds[1].events = POLLIN;
+        pfds[1].revents = 0;
 
-        g_return_val_if_fail(ev != NULL, FALSE);
-        if (!seq_event_is_deliverable(ev)) {
-            g_set_error(error, ALSASEQ_USER_CLIENT_ERROR,
-                        ALSASEQ_USER_CLIENT_ERROR_EVENT_UNDELIVERABLE,
-                        "The operation failes due to undeliverable event: index %lu",
-                        index);
-            return FALSE;
+        if (poll(pfds, G_N_ELEMENTS(pfds), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
         }
-        ++index;
-    }
 
-    seq_event_cntr_serialize(&cntr, events, FALSE);
+        if (pfds[0].revents)
+            break;
+        if (pfds[1].revents & (POLLERR | POLLHUP | POLLNVAL))
+            break;
+        if (!(pfds[1].revents & POLLIN))
+            continue;
 
-    // Nothing to do.
-    if (cntr.length == 0)
-        return TRUE;
+        if (full) {
+            eventfd_t val;
 
-    result = write(priv->fd, cntr.buf, cntr.length);
-    g_free(cntr.buf);
-    if (result < 0) {
-        GFileError code = g_file_error_from_errno(errno);
+            eventfd_read(src->space_fd, &val);
+            g_atomic_int_set((gint *)&src->producer_waiting, 0);
+            continue;
+        }
 
-        if (code != G_FILE_ERROR_FAILED)
-            generate_file_error(error, errno, "write(%s)", priv->devnode);
-        else
-            generate_syscall_error(error, errno, "write(%s)", priv->devnode);
+        slot = src->slots + head % src->slot_count;
+        len = read(priv->fd, slot->buf, src->buf_len);
+        if (len < 0) {
+            if (errno == EAGAIN || errno == EINTR)
+                continue;
+            break;
+        }
 
-        return FALSE;
-    }
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        slot->timestamp = (gint64)ts.tv_sec * G_GINT64_CONSTANT(1000000000) + ts.tv_nsec;
+        slot->length = len;
 
-    // Compute the count of scheduled events.
-    pos = 0;
-    scheduled = 0;
-    for (entry = events; entry != NULL; entry = g_list_next(entry)) {
-        const struct snd_seq_event *ev = (const struct snd_seq_event *)entry->data;
+        if (src->func != NULL) {
+            ALSASeqEventCntr ev_cntr = { 0 };
 
-        ++scheduled;
+            ev_cntr.buf = slot->buf;
+            ev_cntr.length = slot->length;
+            ev_cntr.aligned = TRUE;
 
-        pos += seq_event_calculate_flattened_length(ev, FALSE);
-        if (pos >= result)
-            break;
-    }
+            if (src->func(&ev_cntr, slot->timestamp, src->user_data))
+                continue;
+        }
 
-    g_return_val_if_fail(result == pos, FALSE);
+        g_atomic_int_set((gint *)&src->head, head + 1);
+        eventfd_write(src->wake_fd, 1);
+    }
 
-    *count = scheduled;
+    g_atomic_int_set((gint *)&src->terminated, 1);
+    eventfd_write(src->wake_fd, 1);
 
-    return TRUE;
+    return NULL;
 }
 
-static gboolean seq_user_client_check_src(GSource *gsrc)
+static gboolean seq_user_client_check_reader_src(GSource *gsrc)
 {
-    UserClientSource *src = (UserClientSource *)gsrc;
+    UserClientReaderSource *src = (UserClientReaderSource *)gsrc;
     GIOCondition condition;
 
-    // Don't go to dispatch if nothing available. As an exception, return TRUE
-    // for POLLERR to call .dispatch for internal destruction.
     condition = g_source_query_unix_fd(gsrc, src->tag);
     return !!(condition & (G_IO_IN | G_IO_ERR));
 }
 
-static gboolean seq_user_client_dispatch_src(GSource *gsrc, GSourceFunc cb,
-                                             gpointer user_data)
+static gboolean seq_user_client_dispatch_reader_src(GSource *gsrc, GSourceFunc cb,
+                                                    gpointer user_data)
 {
-    UserClientSource *src = (UserClientSource *)gsrc;
+    UserClientReaderSource *src = (UserClientReaderSource *)gsrc;
     ALSASeqUserClient *self = src->self;
-    ALSASeqUserClientPrivate *priv;
-    GIOCondition condition;
-    ALSASeqEventCntr ev_cntr = { 0 };
-    int len;
+    guint sig = seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_HANDLE_TIMESTAMPED_EVENT];
+    gboolean timestamped;
+    eventfd_t val;
+    guint head;
+    guint tail;
 
-    priv = alsaseq_user_client_get_instance_private(self);
-    if (priv->fd < 0)
-        return G_SOURCE_REMOVE;
+    eventfd_read(src->wake_fd, &val);
 
-    condition = g_source_query_unix_fd(gsrc, src->tag);
-    if (condition & G_IO_ERR)
-        return G_SOURCE_REMOVE;
+    timestamped = ALSASEQ_USER_CLIENT_GET_CLASS(self)->handle_timestamped_event != NULL ||
+                  g_signal_has_handler_pending(self, sig, 0, FALSE);
 
-    len = read(priv->fd, src->buf, src->buf_len);
-    if (len < 0) {
-        if (errno == EAGAIN)
-            return G_SOURCE_CONTINUE;
+    head = g_atomic_int_get((gint *)&src->head);
+    tail = g_atomic_int_get((gint *)&src->tail);
+    if (tail != head) {
+        ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(self);
 
-        return G_SOURCE_REMOVE;
+        stats_add(priv, dispatches, 1);
+    }
+    while (tail != head) {
+        const ReaderSlot *slot = src->slots + tail % src->slot_count;
+        ALSASeqEventCntr ev_cntr = { 0 };
+
+        // NOTE: The buffer is flatten layout.
+        ev_cntr.buf = slot->buf;
+        ev_cntr.length = slot->length;
+        ev_cntr.aligned = TRUE;
+
+        if (timestamped)
+            g_signal_emit(self, sig, 0, &ev_cntr, slot->timestamp);
+        seq_user_client_emit_event_cntr(self, &ev_cntr);
+
+        ++tail;
+        g_atomic_int_set((gint *)&src->tail, tail);
+        if (g_atomic_int_get((gint *)&src->producer_waiting))
+            eventfd_write(src->space_fd, 1);
     }
 
-    // NOTE: The buffer is flatten layout.
-    ev_cntr.buf = src->buf;
-    ev_cntr.length = len;
-    ev_cntr.aligned = TRUE;
-
-    g_signal_emit(self, seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_HANDLE_EVENT], 0, &ev_cntr);
+    if (g_atomic_int_get((gint *)&src->terminated))
+        return G_SOURCE_REMOVE;
 
-    // Just be sure to continue to process this source.
     return G_SOURCE_CONTINUE;
 }
 
-static void seq_user_client_finalize_src(GSource *gsrc)
+static void seq_user_client_finalize_reader_src(GSource *gsrc)
 {
-    UserClientSource *src = (UserClientSource *)gsrc;
+    UserClientReaderSource *src = (UserClientReaderSource *)gsrc;
+
+    if (src->thread_started) {
+        eventfd_write(src->stop_fd, 1);
+        pthread_join(src->thread, NULL);
+    }
+
+    if (src->wake_fd >= 0)
+        close(src->wake_fd);
+    if (src->space_fd >= 0)
+        close(src->space_fd);
+    if (src->stop_fd >= 0)
+        close(src->stop_fd);
+
+    g_free(src->slots);
+    g_free(src->bufs);
+
+    if (src->destroy != NULL)
+        src->destroy(src->user_data);
 
-    g_free(src->buf);
     g_object_unref(src->self);
 }
 
 /**
- * alsaseq_user_client_create_source:
+ * alsaseq_user_client_create_reader_source:
  * @self: A [class@UserClient].
- * @gsrc: (out): A #GSource to handle events from ALSA seq character device.
- * @error: A [struct@GLib.Error].
+ * @buffer_size: The size of each slot to receive events in byte unit. Zero means the size of
+ *               page.
+ * @slot_count: The number of slots in the ring between the reader thread and the context.
+ * @rt_priority: The priority of `SCHED_FIFO` policy for the reader thread. Zero means to inherit
+ *               the policy of the caller.
+ * @lock_memory: Whether to lock the memory of process by `mlockall(2)` system call.
+ * @func: (scope notified) (closure user_data) (destroy destroy) (nullable): The function called
+ *        in the reader thread for each batch of events.
+ * @user_data: The data passed to the function.
+ * @destroy: The function called to release the data at finalization of the source.
+ * @gsrc: (out): A #GSource to dispatch the events read by the reader thread.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
  *
- * Allocate [struct@GLib.Source] structure to handle events from ALSA seq character device. In each
- * iteration of [struct@GLib.MainContext], the `read(2)` system call is exected to dispatch
- * sequencer event for [signal@UserClient::handle-event] signal, according to the result of
- * `poll(2)` system call.
+ * Start the thread to read events from ALSA sequencer character device, then allocate
+ * [struct@GLib.Source] structure to dispatch the events in [struct@GLib.MainContext] to which it
+ * is attached. The reader thread timestamps each batch of events by `CLOCK_MONOTONIC`, then
+ * passes it through the lock-free ring to the context. The context emits
+ * [signal@UserClient::handle-timestamped-event], [signal@UserClient::handle-event], and
+ * [signal@UserClient::handle-typed-event] signals for each batch. When the ring is full, the
+ * reader thread stops reading till any slot becomes available, thus the events are kept in the
+ * memory pool of the client.
+ *
+ * The function is called in the reader thread before the batch is passed to the ring, and the
+ * batch is not passed when the function returns %TRUE. The function should be bounded in time
+ * since it blocks the reader thread. The reader thread stops at finalization of the source.
  *
  * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
  */
-gboolean alsaseq_user_client_create_source(ALSASeqUserClient *self, GSource **gsrc, GError **error)
+gboolean alsaseq_user_client_create_reader_source(ALSASeqUserClient *self, gsize buffer_size,
+                                                  guint slot_count, gint rt_priority,
+                                                  gboolean lock_memory,
+                                                  ALSASeqUserClientReaderFunc func,
+                                                  gpointer user_data, GDestroyNotify destroy,
+                                                  GSource **gsrc, GError **error)
 {
     static GSourceFuncs funcs = {
-            .check          = seq_user_client_check_src,
-            .dispatch       = seq_user_client_dispatch_src,
-            .finalize       = seq_user_client_finalize_src,
+            .check          = seq_user_client_check_reader_src,
+            .dispatch       = seq_user_client_dispatch_reader_src,
+            .finalize       = seq_user_client_finalize_reader_src,
     };
     ALSASeqUserClientPrivate *priv;
-    UserClientSource *src;
-    void *buf;
-    long page_size = sysconf(_SC_PAGESIZE);
+    UserClientReaderSource *src;
+    pthread_attr_t attr;
+    guint i;
+    int err;
 
     g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
     priv = alsaseq_user_client_get_instance_private(self);
     g_return_val_if_fail(priv->fd >= 0, FALSE);
 
+    g_return_val_if_fail(buffer_size == 0 || buffer_size >= sizeof(struct snd_seq_event), FALSE);
+    g_return_val_if_fail(slot_count > 0, FALSE);
+    g_return_val_if_fail(rt_priority >= 0, FALSE);
     g_return_val_if_fail(gsrc != NULL, FALSE);
     g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-    buf = g_malloc0(page_size);
+    if (lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        generate_syscall_error(error, errno, "mlockall(%s)", "MCL_CURRENT | MCL_FUTURE");
+        return FALSE;
+    }
+
+    if (buffer_size == 0)
+        buffer_size = sysconf(_SC_PAGESIZE);
 
     *gsrc = g_source_new(&funcs, sizeof(*src));
-    src = (UserClientSource *)(*gsrc);
+    src = (UserClientReaderSource *)(*gsrc);
 
-    g_source_set_name(*gsrc, "ALSASeqUserClient");
+    g_source_set_name(*gsrc, "ALSASeqUserClientReader");
     g_source_set_priority(*gsrc, G_PRIORITY_HIGH_IDLE);
     g_source_set_can_recurse(*gsrc, TRUE);
 
     src->self = g_object_ref(self);
-    src->tag = g_source_add_unix_fd(*gsrc, priv->fd, G_IO_IN);
-    src->buf = buf;
-    src->buf_len = page_size;
+    src->slots = g_malloc0_n(slot_count, sizeof(*src->slots));
+    src->slot_count = slot_count;
+    src->bufs = g_malloc0_n(slot_count, buffer_size);
+    src->buf_len = buffer_size;
+    for (i = 0; i < slot_count; ++i)
+        src->slots[i].buf = src->bufs + buffer_size * i;
+    src->func = func;
+    src->user_data = user_data;
+    src->destroy = destroy;
+
+    src->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    src->space_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    src->stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (src->wake_fd < 0 || src->space_fd < 0 || src->stop_fd < 0) {
+        generate_syscall_error(error, errno, "eventfd(%s)", "EFD_CLOEXEC | EFD_NONBLOCK");
+        goto failed;
+    }
+
+    src->tag = g_source_add_unix_fd(*gsrc, src->wake_fd, G_IO_IN);
+
+    pthread_attr_init(&attr);
+    if (rt_priority > 0) {
+        struct sched_param param = { .sched_priority = rt_priority };
+
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+    err = pthread_create(&src->thread, &attr, seq_user_client_reader_thread, src);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        generate_syscall_error(error, err, "pthread_create(%s)", "reader");
+        goto failed;
+    }
+    src->thread_started = TRUE;
+
+    return TRUE;
+failed:
+    // The data is released by the caller at failure.
+    src->destroy = NULL;
+    g_source_unref(*gsrc);
+    *gsrc = NULL;
+    return FALSE;
+}
+
+// The pool is grown when the ratio of free cells is less than a quarter in successive samples.
+#define POOL_WATCHER_LOW_RATIO_DENOMINATOR  4
+#define POOL_WATCHER_LOW_STREAK             3
+
+typedef struct {
+    ALSASeqUserClient *self;
+    guint output_pool_limit;
+    guint input_pool_limit;
+    guint output_low_streak;
+    guint input_low_streak;
+    unsigned int output_pool_target;
+    unsigned int input_pool_target;
+    int lost_count;
+} PoolWatcher;
+
+static void seq_user_client_free_pool_watcher(gpointer data)
+{
+    PoolWatcher *watcher = data;
+
+    g_object_unref(watcher->self);
+    g_free(watcher);
+}
+
+// Decide the size to grow the pool after successive samples with less free cells. The size is
+// kept as target till the pool is resized.
+static void seq_user_client_plan_pool_growth(unsigned int size, unsigned int free_cells,
+                                             unsigned int limit, guint *low_streak,
+                                             unsigned int *target)
+{
+    if (free_cells * POOL_WATCHER_LOW_RATIO_DENOMINATOR >= size) {
+        *low_streak = 0;
+        return;
+    }
+
+    if (++(*low_streak) < POOL_WATCHER_LOW_STREAK || size >= limit)
+        return;
+
+    *low_streak = 0;
+    *target = MIN(MAX(size * 2, 1), limit);
+}
+
+// ALSA Sequencer core resizes the pool for each direction in the same call, when the size differs
+// from the current one. The call is therefore done for each direction with the current size of
+// the other direction.
+static void seq_user_client_resize_pool(PoolWatcher *watcher, ALSASeqUserClientPrivate *priv,
+                                        struct snd_seq_client_pool *pool, const char *direction,
+                                        unsigned int *target)
+{
+    GError *error = NULL;
+
+    if (ioctl(priv->fd, SNDRV_SEQ_IOCTL_SET_CLIENT_POOL, pool) < 0) {
+        generate_syscall_error(&error, errno, "ioctl(%s)", direction);
+        g_signal_emit(watcher->self,
+                      seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_POOL_RESIZE_FAILED], 0,
+                      error);
+        g_error_free(error);
+    }
+
+    // Not retried at failure, to avoid emitting the signal at each interval.
+    *target = 0;
+}
+
+static gboolean seq_user_client_watch_pool(gpointer user_data)
+{
+    PoolWatcher *watcher = user_data;
+    ALSASeqUserClientPrivate *priv = alsaseq_user_client_get_instance_private(watcher->self);
+    struct snd_seq_client_info info = {0};
+    struct snd_seq_client_pool pool = {0};
+
+    if (priv->fd < 0)
+        return G_SOURCE_REMOVE;
+
+    info.client = priv->client_id;
+    if (ioctl(priv->fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, &info) == 0 &&
+        info.event_lost != watcher->lost_count) {
+        watcher->lost_count = info.event_lost;
+        g_signal_emit(watcher->self,
+                      seq_user_client_sigs[SEQ_USER_CLIENT_SIG_TYPE_LOST_COUNT_CHANGED], 0,
+                      info.event_lost);
+    }
+
+    pool.client = priv->client_id;
+    if (ioctl(priv->fd, SNDRV_SEQ_IOCTL_GET_CLIENT_POOL, &pool) < 0)
+        return G_SOURCE_CONTINUE;
+
+    seq_user_client_plan_pool_growth(pool.output_pool, pool.output_free,
+                                     watcher->output_pool_limit, &watcher->output_low_streak,
+                                     &watcher->output_pool_target);
+    seq_user_client_plan_pool_growth(pool.input_pool, pool.input_free, watcher->input_pool_limit,
+                                     &watcher->input_low_streak, &watcher->input_pool_target);
+
+    // The resize of output pool fails with EBUSY while any cell is in use, thus it is deferred
+    // till the pool is idle.
+    if (watcher->output_pool_target > 0 && pool.output_free == pool.output_pool) {
+        struct snd_seq_client_pool req = pool;
+
+        req.output_pool = watcher->output_pool_target;
+        seq_user_client_resize_pool(watcher, priv, &req, "SET_CLIENT_POOL(output)",
+                                    &watcher->output_pool_target);
+        pool.output_pool = req.output_pool;
+    }
+
+    // The resize of input pool discards the events pending in the FIFO, thus it is deferred till
+    // the FIFO is empty.
+    if (watcher->input_pool_target > 0 && pool.input_free == pool.input_pool) {
+        struct snd_seq_client_pool req = pool;
+
+        req.input_pool = watcher->input_pool_target;
+        seq_user_client_resize_pool(watcher, priv, &req, "SET_CLIENT_POOL(input)",
+                                    &watcher->input_pool_target);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * alsaseq_user_client_create_pool_watcher_source:
+ * @self: A [class@UserClient].
+ * @interval: The interval to sample in millisecond unit.
+ * @output_pool_limit: The maximum number of cells in memory pool for output direction. Zero
+ *                     means no growth.
+ * @input_pool_limit: The maximum number of cells in memory pool for input direction. Zero means
+ *                    no growth.
+ * @gsrc: (out): A [struct@GLib.Source] to sample the memory pool and the number of lost events.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
+ *
+ * Allocate [struct@GLib.Source] structure to sample [class@ClientPool] and
+ * [property@ClientInfo:lost-count] for the client at the interval. When the number of lost
+ * events is changed, [signal@UserClient::lost-count-changed] signal is emit. When the ratio of
+ * free cells in memory pool stays less than a quarter for three successive samples, the memory
+ * pool is doubled within the limit.
+ *
+ * The resize is deferred till the pool for the direction is idle; for output direction, no cell
+ * is in use, since ALSA Sequencer core refuses the resize with `EBUSY` while any cell is used; for
+ * input direction, no event is pending in the FIFO, since the resize discards the pending events.
+ * Nevertheless, the event arriving between the sample and the resize is discarded. When the
+ * resize fails, [signal@UserClient::pool-resize-failed] signal is emit and the growth is
+ * abandoned till the next successive samples with less free cells.
+ *
+ * The source executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_GET_CLIENT_INFO`,
+ * `SNDRV_SEQ_IOCTL_GET_CLIENT_POOL`, and `SNDRV_SEQ_IOCTL_SET_CLIENT_POOL` commands for ALSA
+ * sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_create_pool_watcher_source(ALSASeqUserClient *self, guint interval,
+                                                        guint output_pool_limit,
+                                                        guint input_pool_limit, GSource **gsrc,
+                                                        GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    struct snd_seq_client_info info = {0};
+    PoolWatcher *watcher;
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(interval > 0, FALSE);
+    g_return_val_if_fail(gsrc != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    info.client = priv->client_id;
+    if (ioctl(priv->fd, SNDRV_SEQ_IOCTL_GET_CLIENT_INFO, &info) < 0) {
+        generate_syscall_error(error, errno, "ioctl(%s)", "GET_CLIENT_INFO");
+        return FALSE;
+    }
+
+    watcher = g_new0(PoolWatcher, 1);
+    watcher->self = g_object_ref(self);
+    watcher->output_pool_limit = output_pool_limit;
+    watcher->input_pool_limit = input_pool_limit;
+    watcher->lost_count = info.event_lost;
+
+    *gsrc = g_timeout_source_new(interval);
+    g_source_set_name(*gsrc, "ALSASeqUserClientPoolWatcher");
+    g_source_set_callback(*gsrc, seq_user_client_watch_pool, watcher,
+                          seq_user_client_free_pool_watcher);
 
     return TRUE;
 }
@@ -849,6 +2641,274 @@ gboolean alsaseq_user_client_operate_subscription(ALSASeqUserClient *self,
     return TRUE;
 }
 
+static int seq_user_client_operate_subs(ALSASeqUserClientPrivate *priv,
+                                        struct snd_seq_port_subscribe *data, gboolean establish)
+{
+    long request = establish ? SNDRV_SEQ_IOCTL_SUBSCRIBE_PORT : SNDRV_SEQ_IOCTL_UNSUBSCRIBE_PORT;
+
+    if (ioctl(priv->fd, request, data) < 0)
+        return errno;
+
+    return 0;
+}
+
+// Operate the subscriptions in the order. At the first failure, the subscriptions already
+// operated are reverted in the reverse order.
+static gboolean seq_user_client_operate_subs_batch(ALSASeqUserClientPrivate *priv,
+                                                   struct snd_seq_port_subscribe **entries,
+                                                   const gboolean *establish, gsize count,
+                                                   gint *results, GError **error)
+{
+    gsize reverted;
+    gsize i;
+    int err;
+
+    for (i = 0; i < count; ++i)
+        results[i] = ECANCELED;
+
+    for (i = 0; i < count; ++i) {
+        err = seq_user_client_operate_subs(priv, entries[i], establish[i]);
+        results[i] = err;
+        if (err != 0)
+            break;
+    }
+    if (i == count)
+        return TRUE;
+
+    reverted = i;
+    while (reverted-- > 0) {
+        // Nothing to do any more when the revert fails.
+        if (seq_user_client_operate_subs(priv, entries[reverted], !establish[reverted]) != 0) {
+            g_set_error(error, ALSASEQ_USER_CLIENT_ERROR, ALSASEQ_USER_CLIENT_ERROR_FAILED,
+                        "ioctl(%s) %d(%s): index %lu, and revert fails at index %lu",
+                        establish[i] ? "SUBSCRIBE_PORT" : "UNSUBSCRIBE_PORT", err,
+                        strerror(err), i, reverted);
+            return FALSE;
+        }
+    }
+
+    if (err == EPERM) {
+        generate_local_error(error, ALSASEQ_USER_CLIENT_ERROR_PORT_PERMISSION);
+    } else {
+        g_set_error(error, ALSASEQ_USER_CLIENT_ERROR, ALSASEQ_USER_CLIENT_ERROR_FAILED,
+                    "ioctl(%s) %d(%s): index %lu",
+                    establish[i] ? "SUBSCRIBE_PORT" : "UNSUBSCRIBE_PORT", err, strerror(err), i);
+    }
+
+    return FALSE;
+}
+
+/**
+ * alsaseq_user_client_operate_subscriptions:
+ * @self: A [class@UserClient].
+ * @entries: (array length=count): The array of [class@SubscribeData].
+ * @establish: (array length=count): The array of flags whether to establish subscription or break
+ *             it for each entry.
+ * @count: The number of entries.
+ * @results: (array length=count)(out)(transfer full)(optional): The array of result for each
+ *           entry; zero when the operation finished, the error number when the operation failed,
+ *           and `ECANCELED` when the operation was not attempted.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
+ *
+ * Operate the batch of subscriptions in the order. The operation stops at the first failure, then
+ * the operations already finished are reverted in the reverse order so that the state of
+ * subscriptions is the same as before the call.
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_SUBSCRIBE_PORT` and
+ * `SNDRV_SEQ_IOCTL_UNSUBSCRIBE_PORT` commands for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_operate_subscriptions(ALSASeqUserClient *self,
+                                                   ALSASeqSubscribeData *const *entries,
+                                                   const gboolean *establish, gsize count,
+                                                   gint **results, GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    struct snd_seq_port_subscribe **data;
+    gint *codes;
+    gboolean result;
+    gsize i;
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(entries != NULL || count == 0, FALSE);
+    g_return_val_if_fail(establish != NULL || count == 0, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    data = g_new0(struct snd_seq_port_subscribe *, count);
+    for (i = 0; i < count; ++i) {
+        if (!ALSASEQ_IS_SUBSCRIBE_DATA(entries[i])) {
+            g_free(data);
+            g_return_val_if_reached(FALSE);
+        }
+        seq_subscribe_data_refer_private(entries[i], &data[i]);
+    }
+
+    codes = g_new0(gint, count);
+    result = seq_user_client_operate_subs_batch(priv, data, establish, count, codes, error);
+    g_free(data);
+
+    if (results != NULL)
+        *results = codes;
+    else
+        g_free(codes);
+
+    return result;
+}
+
+static gboolean seq_user_client_subs_equal(const struct snd_seq_port_subscribe *lhs,
+                                           const struct snd_seq_port_subscribe *rhs)
+{
+    return lhs->sender.client == rhs->sender.client && lhs->sender.port == rhs->sender.port &&
+           lhs->dest.client == rhs->dest.client && lhs->dest.port == rhs->dest.port &&
+           lhs->flags == rhs->flags && lhs->queue == rhs->queue;
+}
+
+static gboolean seq_user_client_subs_include(const struct snd_seq_port_subscribe *entry,
+                                             ALSASeqSubscribeData *const *entries, gsize count)
+{
+    gsize i;
+
+    for (i = 0; i < count; ++i) {
+        struct snd_seq_port_subscribe *data;
+
+        seq_subscribe_data_refer_private(entries[i], &data);
+        if (seq_user_client_subs_equal(entry, data))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/**
+ * alsaseq_user_client_sync_subscriptions:
+ * @self: A [class@UserClient].
+ * @current: (array length=current_count): The array of [class@SubscribeData] for current
+ *           subscriptions, typically retrieved by [func@get_subscription_list].
+ * @current_count: The number of entries in current subscriptions.
+ * @desired: (array length=desired_count): The array of [class@SubscribeData] for desired
+ *           subscriptions.
+ * @desired_count: The number of entries in desired subscriptions.
+ * @changed: (out): The number of subscriptions to be operated.
+ * @current_results: (array length=current_count)(out)(transfer full)(optional): The array of
+ *                   result for each entry of current subscriptions; zero when the subscription
+ *                   is kept or broken, the error number when the operation failed, and
+ *                   `ECANCELED` when the operation was not attempted.
+ * @desired_results: (array length=desired_count)(out)(transfer full)(optional): The array of
+ *                   result for each entry of desired subscriptions; zero when the subscription
+ *                   is kept or established, the error number when the operation failed, and
+ *                   `ECANCELED` when the operation was not attempted.
+ * @error: A [struct@GLib.Error]. Error is generated with domain of `ALSASeq.UserClientError`.
+ *
+ * Operate the subscriptions so that the current subscriptions become the desired subscriptions.
+ * The current subscriptions not included in the desired subscriptions are broken at first, then
+ * the desired subscriptions not included in the current subscriptions are established. The
+ * subscriptions included in both are not touched. The subscription is identified by the
+ * addresses of sender and destination, the flags, and the numeric ID of queue. The operations are
+ * done as well as [method@UserClient.operate_subscriptions], thus they are reverted at failure.
+ *
+ * The call of function executes `ioctl(2)` system call with `SNDRV_SEQ_IOCTL_SUBSCRIBE_PORT` and
+ * `SNDRV_SEQ_IOCTL_UNSUBSCRIBE_PORT` commands for ALSA sequencer character device.
+ *
+ * Returns: %TRUE when the overall operation finishes successfully, else %FALSE.
+ */
+gboolean alsaseq_user_client_sync_subscriptions(ALSASeqUserClient *self,
+                                                ALSASeqSubscribeData *const *current,
+                                                gsize current_count,
+                                                ALSASeqSubscribeData *const *desired,
+                                                gsize desired_count, gsize *changed,
+                                                gint **current_results, gint **desired_results,
+                                                GError **error)
+{
+    ALSASeqUserClientPrivate *priv;
+    struct snd_seq_port_subscribe **data;
+    gboolean *establish;
+    gsize *indices;
+    gint *codes;
+    gint *current_codes;
+    gint *desired_codes;
+    gsize count;
+    gboolean result;
+    gsize i;
+
+    g_return_val_if_fail(ALSASEQ_IS_USER_CLIENT(self), FALSE);
+    priv = alsaseq_user_client_get_instance_private(self);
+
+    g_return_val_if_fail(current != NULL || current_count == 0, FALSE);
+    g_return_val_if_fail(desired != NULL || desired_count == 0, FALSE);
+    g_return_val_if_fail(changed != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    for (i = 0; i < current_count; ++i)
+        g_return_val_if_fail(ALSASEQ_IS_SUBSCRIBE_DATA(current[i]), FALSE);
+    for (i = 0; i < desired_count; ++i)
+        g_return_val_if_fail(ALSASEQ_IS_SUBSCRIBE_DATA(desired[i]), FALSE);
+
+    // The index of entry is kept for each operation, to map the result to the entry.
+    data = g_new0(struct snd_seq_port_subscribe *, current_count + desired_count);
+    establish = g_new0(gboolean, current_count + desired_count);
+    indices = g_new0(gsize, current_count + desired_count);
+    count = 0;
+
+    for (i = 0; i < current_count; ++i) {
+        struct snd_seq_port_subscribe *entry;
+
+        seq_subscribe_data_refer_private(current[i], &entry);
+        if (!seq_user_client_subs_include(entry, desired, desired_count)) {
+            data[count] = entry;
+            establish[count] = FALSE;
+            indices[count] = i;
+            ++count;
+        }
+    }
+
+    for (i = 0; i < desired_count; ++i) {
+        struct snd_seq_port_subscribe *entry;
+
+        seq_subscribe_data_refer_private(desired[i], &entry);
+        if (!seq_user_client_subs_include(entry, current, current_count)) {
+            data[count] = entry;
+            establish[count] = TRUE;
+            indices[count] = i;
+            ++count;
+        }
+    }
+
+    codes = g_new0(gint, count);
+    result = seq_user_client_operate_subs_batch(priv, data, establish, count, codes, error);
+
+    // The operation to break subscription is for the entry of current subscriptions.
+    current_codes = g_new0(gint, current_count);
+    desired_codes = g_new0(gint, desired_count);
+    for (i = 0; i < count; ++i) {
+        if (!establish[i])
+            current_codes[indices[i]] = codes[i];
+        else
+            desired_codes[indices[i]] = codes[i];
+    }
+
+    if (current_results != NULL)
+        *current_results = current_codes;
+    else
+        g_free(current_codes);
+    if (desired_results != NULL)
+        *desired_results = desired_codes;
+    else
+        g_free(desired_codes);
+
+    g_free(codes);
+    g_free(indices);
+    g_free(establish);
+    g_free(data);
+
+    if (result)
+        *changed = count;
+
+    return result;
+}
+
 /**
  * alsaseq_user_client_create_queue:
  * @self: A [class@UserClient].
@@ -14,6 +14,19 @@ G_DECLARE_DERIVABLE_TYPE(ALSASeqUserClient, alsaseq_user_client, ALSASEQ, USER_C
 
 GQuark alsaseq_user_client_error_quark();
 
+/**
+ * ALSASeqUserClientReaderFunc:
+ * @ev_cntr: (transfer none): The instance of [struct@EventCntr] which includes batch of events.
+ * @timestamp: The value of `CLOCK_MONOTONIC` in nanosecond unit when the batch was read.
+ * @user_data: The data passed by [method@UserClient.create_reader_source].
+ *
+ * The function called in the reader thread for each batch of events.
+ *
+ * Returns: %TRUE when the batch is consumed, else %FALSE to pass it to the context.
+ */
+typedef gboolean (*ALSASeqUserClientReaderFunc)(const ALSASeqEventCntr *ev_cntr, gint64 timestamp,
+                                                gpointer user_data);
+
 struct _ALSASeqUserClientClass {
     GObjectClass parent_class;
 
@@ -26,6 +39,62 @@ struct _ALSASeqUserClientClass {
      * events.
      */
     void (*handle_event)(ALSASeqUserClient *self, const ALSASeqEventCntr *ev_cntr);
+
+    /**
+     * ALSASeqUserClientClass::handle_typed_event:
+     * @self: A [class@UserClient].
+     * @event: (transfer none): The instance of [struct@Event].
+     *
+     * When event occurs, this signal is emit for each event in the batch with detail for the
+     * type of event.
+     */
+    void (*handle_typed_event)(ALSASeqUserClient *self, const ALSASeqEvent *event);
+
+    /**
+     * ALSASeqUserClientClass::flushed:
+     * @self: A [class@UserClient].
+     *
+     * When all of events pending in output queue are written, this signal is emit.
+     */
+    void (*flushed)(ALSASeqUserClient *self);
+
+    /**
+     * ALSASeqUserClientClass::handle_timestamped_event:
+     * @self: A [class@UserClient].
+     * @ev_cntr: (transfer none): The instance of [struct@EventCntr] which includes batch of events.
+     * @timestamp: The value of `CLOCK_MONOTONIC` in nanosecond unit when the batch was read.
+     *
+     * When the batch of events is passed from the reader thread, this signal is emit.
+     */
+    void (*handle_timestamped_event)(ALSASeqUserClient *self, const ALSASeqEventCntr *ev_cntr,
+                                     gint64 timestamp);
+
+    /**
+     * ALSASeqUserClientClass::lost_count_changed:
+     * @self: A [class@UserClient].
+     * @lost_count: The current value of [property@ClientInfo:lost-count] for the client.
+     *
+     * When the number of lost events for the client is changed, this signal is emit.
+     */
+    void (*lost_count_changed)(ALSASeqUserClient *self, gint lost_count);
+
+    /**
+     * ALSASeqUserClientClass::barrier_reached:
+     * @self: A [class@UserClient].
+     * @token: The token returned by [method@UserClient.schedule_barrier].
+     *
+     * When the echo event scheduled as barrier returns to the client, this signal is emit.
+     */
+    void (*barrier_reached)(ALSASeqUserClient *self, guint token);
+
+    /**
+     * ALSASeqUserClientClass::pool_resize_failed:
+     * @self: A [class@UserClient].
+     * @error: A [struct@GLib.Error] with domain of `ALSASeq.UserClientError`.
+     *
+     * When the memory pool fails to be resized by the pool watcher, this signal is emit.
+     */
+    void (*pool_resize_failed)(ALSASeqUserClient *self, const GError *error);
 };
 
 ALSASeqUserClient *alsaseq_user_client_new();
@@ -41,6 +110,10 @@ gboolean alsaseq_user_client_set_info(ALSASeqUserClient *self, ALSASeqClientInfo
 gboolean alsaseq_user_client_get_info(ALSASeqUserClient *self,
                                       ALSASeqClientInfo *const *client_info, GError **error);
 
+gboolean alsaseq_user_client_set_event_filter(ALSASeqUserClient *self,
+                                              const ALSASeqEventType *event_types,
+                                              gsize event_type_count, GError **error);
+
 gboolean alsaseq_user_client_create_port(ALSASeqUserClient *self,
                                          ALSASeqPortInfo *const *port_info, GError **error);
 gboolean alsaseq_user_client_create_port_at(ALSASeqUserClient *self,
@@ -58,17 +131,70 @@ gboolean alsaseq_user_client_set_pool(ALSASeqUserClient *self, ALSASeqClientPool
 gboolean alsaseq_user_client_get_pool(ALSASeqUserClient *self,
                                       ALSASeqClientPool *const *client_pool, GError **error);
 
+gboolean alsaseq_user_client_reserve_send_arena(ALSASeqUserClient *self, gsize limit,
+                                                GError **error);
+
+gboolean alsaseq_user_client_set_output_queue_size(ALSASeqUserClient *self, gsize size,
+                                                   GError **error);
+
+void alsaseq_user_client_set_coalescing_window(ALSASeqUserClient *self, guint window);
+
+void alsaseq_user_client_set_pointer_data_threshold(ALSASeqUserClient *self, gsize threshold);
+
 gboolean alsaseq_user_client_schedule_event(ALSASeqUserClient *self, const ALSASeqEvent *event,
                                             GError **error);
 gboolean alsaseq_user_client_schedule_events(ALSASeqUserClient *self, const GList *events,
                                              gsize *count, GError **error);
+gboolean alsaseq_user_client_schedule_event_cntr(ALSASeqUserClient *self,
+                                                 const ALSASeqEventCntr *ev_cntr, gsize *count,
+                                                 GError **error);
+
+gboolean alsaseq_user_client_schedule_barrier(ALSASeqUserClient *self, guint8 port_id,
+                                              const ALSASeqEvent *last_event, guint *token,
+                                              GError **error);
 
 gboolean alsaseq_user_client_create_source(ALSASeqUserClient *self, GSource **gsrc, GError **error);
+gboolean alsaseq_user_client_create_source_full(ALSASeqUserClient *self, gsize buffer_size,
+                                                guint max_reads, GSource **gsrc, GError **error);
+
+gboolean alsaseq_user_client_create_pool_watcher_source(ALSASeqUserClient *self, guint interval,
+                                                        guint output_pool_limit,
+                                                        guint input_pool_limit, GSource **gsrc,
+                                                        GError **error);
+
+void alsaseq_user_client_add_forward_route(ALSASeqUserClient *self,
+                                           const ALSASeqForwardRoute *route);
+
+void alsaseq_user_client_clear_forward_routes(ALSASeqUserClient *self);
+
+void alsaseq_user_client_get_stats(ALSASeqUserClient *self, ALSASeqUserClientStats *stats);
+
+void alsaseq_user_client_reset_stats(ALSASeqUserClient *self);
+
+gboolean alsaseq_user_client_create_reader_source(ALSASeqUserClient *self, gsize buffer_size,
+                                                  guint slot_count, gint rt_priority,
+                                                  gboolean lock_memory,
+                                                  ALSASeqUserClientReaderFunc func,
+                                                  gpointer user_data, GDestroyNotify destroy,
+                                                  GSource **gsrc, GError **error);
 
 gboolean alsaseq_user_client_operate_subscription(ALSASeqUserClient *self,
                                                   ALSASeqSubscribeData *subs_data,
                                                   gboolean establish, GError **error);
 
+gboolean alsaseq_user_client_operate_subscriptions(ALSASeqUserClient *self,
+                                                   ALSASeqSubscribeData *const *entries,
+                                                   const gboolean *establish, gsize count,
+                                                   gint **results, GError **error);
+
+gboolean alsaseq_user_client_sync_subscriptions(ALSASeqUserClient *self,
+                                                ALSASeqSubscribeData *const *current,
+                                                gsize current_count,
+                                                ALSASeqSubscribeData *const *desired,
+                                                gsize desired_count, gsize *changed,
+                                                gint **current_results, gint **desired_results,
+                                                GError **error);
+
 gboolean alsaseq_user_client_create_queue(ALSASeqUserClient *self,
                                           ALSASeqQueueInfo *const *queue_info, GError **error);
 gboolean alsaseq_user_client_delete_queue(ALSASeqUserClient *self, guint8 queue_id, GError **error);